@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "Course.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+
+// Pieces shared by the benchmark programs: "--name=value" option parsing
+// and a synthetic catalog of prerequisite levels with student transcripts.
+namespace bench {
+
+// The text after "name=" when `arg` is that option, otherwise nullptr.
+inline const char* optionValue(const char* arg, const char* name) {
+    const std::size_t length = std::strlen(name);
+    return std::strncmp(arg, name, length) == 0 && arg[length] == '=' ? arg + length + 1 : nullptr;
+}
+
+struct CatalogShape {
+    std::int32_t courses = 2000;
+    std::int32_t depth = 4;           // prerequisite chain length, in levels; at most `courses`
+    double zipf = 0.0;                // popularity skew; 0 is uniform
+    std::uint16_t capacity = Course::kUnlimitedCapacity;
+    bool variedCredits = false;       // 1-5 credits per course instead of 3
+    bool skipLevels = false;          // a quarter of prerequisites come from any lower level
+};
+
+struct Catalog {
+    std::vector<double> popularity;                  // weight per course id - 1
+    std::vector<std::vector<std::int32_t>> levels;   // course ids per level
+    std::vector<std::discrete_distribution<std::size_t>> pickInLevel;   // popularity-weighted, per level
+
+    std::int32_t pick(std::size_t level, std::mt19937& rng) { return levels[level][pickInLevel[level](rng)]; }
+};
+
+// Course ids are 1..M, split evenly over `depth` levels, and popularity is
+// Zipf over a random ranking. Every course above level 0 requires one or two
+// courses from the level directly below (or, with skipLevels, sometimes
+// from any lower level), which keeps the graph acyclic. Prerequisites are
+// drawn by popularity, so busy courses tend to build on busy courses, as
+// gateway courses do. Courses are registered level by level, so each
+// prerequisite exists before its dependents.
+inline Catalog buildCatalog(const CatalogShape& shape, CourseRegistry& courses, std::mt19937& rng) {
+    Catalog catalog;
+    std::vector<std::int32_t> ranking(static_cast<std::size_t>(shape.courses));
+    for (std::size_t i = 0; i < ranking.size(); ++i) ranking[i] = static_cast<std::int32_t>(i + 1);
+    std::shuffle(ranking.begin(), ranking.end(), rng);
+    catalog.popularity.resize(ranking.size());
+    for (std::size_t rank = 0; rank < ranking.size(); ++rank) {
+        catalog.popularity[static_cast<std::size_t>(ranking[rank] - 1)] =
+            1.0 / std::pow(static_cast<double>(rank + 1), shape.zipf);
+    }
+
+    catalog.levels.resize(static_cast<std::size_t>(shape.depth));
+    for (std::int32_t id = 1; id <= shape.courses; ++id) {
+        catalog.levels[static_cast<std::size_t>((id - 1) % shape.depth)].push_back(id);
+    }
+    for (const auto& level : catalog.levels) {
+        std::vector<double> weights;
+        for (std::int32_t id : level) weights.push_back(catalog.popularity[static_cast<std::size_t>(id - 1)]);
+        catalog.pickInLevel.emplace_back(weights.begin(), weights.end());
+    }
+
+    for (std::size_t level = 0; level < catalog.levels.size(); ++level) {
+        for (std::int32_t id : catalog.levels[level]) {
+            std::vector<std::int32_t> prerequisites;
+            const std::size_t count = level == 0 ? 0 : 1 + rng() % 2;
+            for (std::size_t k = 0; k < count; ++k) {
+                const std::size_t below = shape.skipLevels && rng() % 4 == 0 ? rng() % level : level - 1;
+                const std::int32_t prereq = catalog.pick(below, rng);
+                if (std::find(prerequisites.begin(), prerequisites.end(), prereq) == prerequisites.end()) {
+                    prerequisites.push_back(prereq);
+                }
+            }
+            const auto credits = static_cast<std::uint8_t>(shape.variedCredits ? 1 + rng() % 5 : 3);
+            courses.emplaceCourse(id, "Course " + std::to_string(id), credits, "Staff", std::move(prerequisites),
+                                  shape.capacity);
+        }
+    }
+    return catalog;
+}
+
+// Past terms: students 1..`students` each finished 0..maxLevels levels,
+// taking one popularity-weighted course per level plus whatever that
+// course needed. The students must already be registered.
+inline void buildTranscripts(Catalog& catalog, std::int32_t students, std::size_t maxLevels,
+                             const CourseRegistry& courses, EnrollmentManager& manager, std::mt19937& rng) {
+    const auto past = std::chrono::system_clock::now() - std::chrono::hours(24 * 365);
+    maxLevels = std::min(maxLevels, catalog.levels.size());
+    std::vector<std::int32_t> pending;
+    std::vector<std::int32_t> taken;
+    for (std::int32_t studentId = 1; studentId <= students; ++studentId) {
+        taken.clear();
+        const std::size_t levelsDone = rng() % (maxLevels + 1);
+        for (std::size_t level = 0; level < levelsDone; ++level) {
+            pending.push_back(catalog.pick(level, rng));
+        }
+        while (!pending.empty()) {
+            const std::int32_t courseId = pending.back();
+            pending.pop_back();
+            if (std::find(taken.begin(), taken.end(), courseId) != taken.end()) continue;
+            taken.push_back(courseId);
+            manager.restoreEnrollment(Enrollment(studentId, courseId, Enrollment::Status::Completed, past));
+            const Course* course = courses.findCourse(courseId);
+            pending.insert(pending.end(), course->prerequisites().begin(), course->prerequisites().end());
+        }
+    }
+}
+
+} // namespace bench
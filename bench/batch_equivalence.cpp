@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "MutationLog.h"
+#include "WaitlistManager.h"
+
+// Checks that EnrollmentManager::enrollBatch behaves exactly like calling
+// enrollStudent for each request in order. Every round builds two managers
+// over the same students and courses, gives both the same history, then
+// sends one random batch (duplicates, unknown ids, full, closed and
+// unlimited courses, students already waitlisted) to one manager as a batch
+// and to the other request by request. Results, rosters, waitlists,
+// transcripts and the mutation log must match, and the batch's log must
+// never take a student off a waitlist before recording their enrollment.
+// Exits non-zero on any mismatch.
+//
+// Usage: batch_equivalence [rounds] [requests per batch]
+
+namespace {
+
+constexpr std::int32_t kStudents = 60;
+constexpr std::int32_t kCourses = 24;
+
+int g_failures = 0;
+
+void check(bool condition, const char* what, std::int32_t round, std::int32_t id) {
+    if (!condition) {
+        ++g_failures;
+        std::cerr << "FAILED: " << what << " (round " << round << ", id " << id << ")\n";
+    }
+}
+
+// Keeps the enrollment and waitlist events, without timestamps, in order.
+class RecordingLog final : public MutationLog {
+public:
+    enum class Event { EnrollmentAdded, StatusChanged, WaitlistAdded, WaitlistPopped, WaitlistRemoved };
+    using Entry = std::tuple<Event, std::int32_t, std::int32_t, int>;   // event, course, student, status
+
+    std::vector<Entry> entries;
+
+    void studentAdded(const Student&) override {}
+    void studentRemoved(std::int32_t) override {}
+    void studentUpdated(const Student&) override {}
+    void courseAdded(const Course&) override {}
+    void courseRemoved(std::int32_t) override {}
+    void coursePrerequisitesChanged(const Course&) override {}
+    void courseUpdated(const Course&) override {}
+    void courseCapacityChanged(std::int32_t, std::uint16_t) override {}
+    void enrollmentAdded(const Enrollment& enrollment) override {
+        entries.emplace_back(Event::EnrollmentAdded, enrollment.courseId(), enrollment.studentId(),
+                             static_cast<int>(enrollment.status()));
+    }
+    void enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status) override {
+        entries.emplace_back(Event::StatusChanged, courseId, studentId, static_cast<int>(status));
+    }
+    void waitlistAdded(std::int32_t courseId, std::int32_t studentId) override {
+        entries.emplace_back(Event::WaitlistAdded, courseId, studentId, 0);
+    }
+    void waitlistPopped(std::int32_t courseId) override { entries.emplace_back(Event::WaitlistPopped, courseId, 0, 0); }
+    void waitlistRemoved(std::int32_t courseId, std::int32_t studentId) override {
+        entries.emplace_back(Event::WaitlistRemoved, courseId, studentId, 0);
+    }
+};
+
+std::vector<std::int32_t> roster(const EnrollmentManager& manager, std::int32_t courseId) {
+    std::vector<std::int32_t> ids;
+    for (const Enrollment& enrollment : manager.getCourseEnrollments(courseId)) {
+        ids.push_back(enrollment.studentId());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void runRound(std::int32_t round, std::size_t batchSize) {
+    std::mt19937 rng(static_cast<std::uint32_t>(round));
+    StudentRegistry students;
+    CourseRegistry courses;
+    for (std::int32_t id = 1; id <= kStudents; ++id) {
+        students.emplaceStudent(id, "Student");
+    }
+    // The upper half requires the matching lower-half course. Capacities
+    // mix closed, small, and unlimited courses.
+    for (std::int32_t id = 1; id <= kCourses; ++id) {
+        std::vector<std::int32_t> prerequisites;
+        if (id > kCourses / 2) {
+            prerequisites.push_back(id - kCourses / 2);
+        }
+        const std::uint32_t kind = rng() % 6;
+        const std::uint16_t capacity = kind == 0   ? 0
+                                       : kind == 1 ? Course::kUnlimitedCapacity
+                                                   : static_cast<std::uint16_t>(1 + rng() % 6);
+        courses.emplaceCourse(id, "Course", 3, "Staff", std::move(prerequisites), capacity);
+    }
+
+    WaitlistManager sequentialWaitlists, batchWaitlists;
+    EnrollmentManager sequential(students, courses), batch(students, courses);
+    sequential.setWaitlistManager(&sequentialWaitlists);
+    batch.setWaitlistManager(&batchWaitlists);
+
+    // Shared history: some completed lower-half courses, some active rows,
+    // and waitlist entries, including ones for courses with free seats.
+    auto both = [&](auto&& fn) { fn(sequential, sequentialWaitlists); fn(batch, batchWaitlists); };
+    for (int i = 0; i < 150; ++i) {
+        const std::int32_t studentId = static_cast<std::int32_t>(1 + rng() % kStudents);
+        const std::int32_t courseId = static_cast<std::int32_t>(1 + rng() % kCourses);
+        const std::uint32_t kind = rng() % 3;
+        both([&](EnrollmentManager& manager, WaitlistManager& waitlists) {
+            if (kind == 0) {
+                manager.enrollStudent(studentId, courseId);
+                manager.setEnrollmentStatus(studentId, courseId, Enrollment::Status::Completed);
+            } else if (kind == 1) {
+                manager.enrollStudent(studentId, courseId);
+            } else {
+                waitlists.addToWaitlist(courseId, studentId);
+            }
+        });
+    }
+
+    RecordingLog sequentialLog, batchLog;
+    sequential.setMutationLog(&sequentialLog);
+    batch.setMutationLog(&batchLog);
+    sequentialWaitlists.setMutationLog(&sequentialLog);
+    batchWaitlists.setMutationLog(&batchLog);
+
+    // Ids past the registries' ranges exercise StudentNotFound and CourseNotFound.
+    std::vector<EnrollmentManager::EnrollRequest> requests;
+    for (std::size_t i = 0; i < batchSize; ++i) {
+        requests.emplace_back(static_cast<std::int32_t>(1 + rng() % (kStudents + 5)),
+                              static_cast<std::int32_t>(1 + rng() % (kCourses + 2)));
+    }
+    std::vector<EnrollmentManager::EnrollmentResult> expected;
+    for (const auto& [studentId, courseId] : requests) {
+        expected.push_back(sequential.enrollStudent(studentId, courseId));
+    }
+    const auto results = batch.enrollBatch(requests);
+
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        check(results[i] == expected[i], "result differs", round, static_cast<std::int32_t>(i));
+    }
+    for (std::int32_t courseId = 1; courseId <= kCourses + 2; ++courseId) {
+        check(roster(sequential, courseId) == roster(batch, courseId), "roster differs", round, courseId);
+        check(sequential.activeEnrollmentCount(courseId) == batch.activeEnrollmentCount(courseId),
+              "seat count differs", round, courseId);
+        check(sequentialWaitlists.getWaitlist(courseId) == batchWaitlists.getWaitlist(courseId),
+              "waitlist differs", round, courseId);
+    }
+    for (std::int32_t studentId = 1; studentId <= kStudents + 5; ++studentId) {
+        check(sequential.getStudentEnrollments(studentId).size() == batch.getStudentEnrollments(studentId).size(),
+              "transcript differs", round, studentId);
+        check(sequential.getCompletedCourses(studentId) == batch.getCompletedCourses(studentId),
+              "completed set differs", round, studentId);
+    }
+
+    // Same events, in a different order: the batch groups them by course.
+    auto sortedEntries = [](std::vector<RecordingLog::Entry> entries) {
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    };
+    check(sortedEntries(sequentialLog.entries) == sortedEntries(batchLog.entries), "log differs", round, 0);
+    for (std::size_t i = 0; i < batchLog.entries.size(); ++i) {
+        const auto& [event, courseId, studentId, status] = batchLog.entries[i];
+        if (event != RecordingLog::Event::WaitlistRemoved) continue;
+        const RecordingLog::Entry added{RecordingLog::Event::EnrollmentAdded, courseId, studentId,
+                                        static_cast<int>(Enrollment::Status::Active)};
+        check(std::find(batchLog.entries.begin(), batchLog.entries.begin() + static_cast<std::ptrdiff_t>(i), added) !=
+                  batchLog.entries.begin() + static_cast<std::ptrdiff_t>(i),
+              "waitlist removal logged before the enrollment", round, studentId);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::int32_t rounds = argc > 1 ? std::atoi(argv[1]) : 200;
+    const std::size_t batchSize = argc > 2 ? static_cast<std::size_t>(std::atoll(argv[2])) : 400;
+
+    for (std::int32_t round = 0; round < rounds; ++round) {
+        runRound(round, batchSize);
+    }
+
+    if (g_failures != 0) {
+        std::cerr << g_failures << " mismatches\n";
+        return 1;
+    }
+    std::cout << rounds << " rounds x " << batchSize << " requests: batch matches sequential\n";
+    return 0;
+}
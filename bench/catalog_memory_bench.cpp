@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Course.h"
+#include "PrefixIndex.h"
+#include "BenchSupport.h"
+
+// Interned-instructor catalog benchmark.
+//
+// Builds the same synthetic catalog twice: once with the old Course layout,
+// which owned its instructor name as a std::string and was indexed by the
+// normalized name, and once as Course, which holds two StringPool ids and
+// is indexed by the key id. Each catalog is a vector of heap-allocated
+// courses plus an instructor index shaped like CourseRegistry's. Reports
+// the live heap bytes of each (counted by replacing operator new/delete),
+// then times the instructor operations the ids turn into integer work:
+//
+//   filter  count the courses of one instructor, for each query name
+//   group   count courses per instructor over the whole catalog
+//
+// Instructor names are drawn with a skew, so a few teach many sections.
+//
+// Usage: catalog_memory_bench [--courses=N] [--instructors=K] [--queries=Q] [--seed=X]
+
+namespace {
+
+std::atomic<std::size_t> g_heapBytes{0};
+
+// Every block carries its size ahead of the user pointer, aligned for any type.
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+void* countedAlloc(std::size_t size) {
+    void* block = std::malloc(size + kHeader);
+    if (!block) throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    g_heapBytes.fetch_add(size, std::memory_order_relaxed);
+    return static_cast<char*>(block) + kHeader;
+}
+
+void countedFree(void* pointer) noexcept {
+    if (!pointer) return;
+    void* block = static_cast<char*>(pointer) - kHeader;
+    g_heapBytes.fetch_sub(*static_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { countedFree(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::int32_t courses = 100000;
+    std::int32_t instructors = 300;
+    std::size_t queries = 1000;
+    std::uint32_t seed = 2024;
+};
+
+bool parseOption(const char* arg, Options& options) {
+    using bench::optionValue;
+    if (const char* v = optionValue(arg, "--courses")) options.courses = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--instructors")) options.instructors = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--queries")) options.queries = std::strtoull(v, nullptr, 10);
+    else if (const char* v = optionValue(arg, "--seed")) options.seed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 10));
+    else return false;
+    return true;
+}
+
+// Course as it was before interning: the instructor name owned inline.
+struct OwnedCourse {
+    std::int32_t m_id;
+    std::string m_name;
+    std::uint8_t m_credits;
+    std::string m_instructor;
+    std::vector<std::int32_t> m_prerequisites;
+    std::uint64_t m_prerequisitesStamp;
+    std::uint16_t m_capacity;
+};
+
+struct CourseSpec {
+    std::int32_t id;
+    std::string name;
+    std::uint8_t credits;
+    std::string instructor;
+};
+
+std::vector<CourseSpec> makeCatalog(const Options& options) {
+    static const char* const first[] = {"Ada", "Grace", "Alan", "Edsger", "Barbara", "Donald", "Frances", "John",
+                                        "Margaret", "Niklaus", "Radia", "Tony", "Leslie", "Shafi", "Ken"};
+    static const char* const last[] = {"Lovelace", "Hopper", "Turing", "Dijkstra", "Liskov", "Knuth", "Allen",
+                                       "McCarthy", "Hamilton", "Wirth", "Perlman", "Hoare", "Lamport", "Goldwasser"};
+    std::vector<std::string> names;
+    for (std::int32_t i = 0; i < options.instructors; ++i) {
+        names.push_back(std::string("Professor ") + first[i % 15] + ' ' + last[(i / 15) % 14] + ' ' +
+                        std::to_string(i / 210 + 1));
+    }
+
+    std::mt19937 rng(options.seed);
+    // Skewed pick: squaring a uniform draw favours the low indexes.
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> credits(1, 5);
+    std::vector<CourseSpec> catalog;
+    catalog.reserve(static_cast<std::size_t>(options.courses));
+    for (std::int32_t id = 1; id <= options.courses; ++id) {
+        const double u = unit(rng);
+        const auto instructor = static_cast<std::size_t>(u * u * static_cast<double>(names.size()));
+        catalog.push_back({id, "Course section " + std::to_string(id), static_cast<std::uint8_t>(credits(rng)),
+                           names[std::min(instructor, names.size() - 1)]});
+    }
+    return catalog;
+}
+
+template <typename Fn>
+double nsPer(std::size_t count, Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(count);
+}
+
+volatile std::size_t g_sink;   // keeps the loops from being optimized away
+
+double mib(std::size_t bytes) { return static_cast<double>(bytes) / (1 << 20); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseOption(argv[i], options)) {
+            std::cerr << "unknown option: " << argv[i] << "\n"
+                      << "usage: catalog_memory_bench [--courses=N] [--instructors=K] [--queries=Q] [--seed=X]\n";
+            return 1;
+        }
+    }
+
+    const std::vector<CourseSpec> catalog = makeCatalog(options);
+    std::mt19937 rng(options.seed + 1);
+    std::uniform_int_distribution<std::size_t> pick(0, catalog.size() - 1);
+    std::vector<std::string> queries(options.queries);
+    for (std::string& query : queries) query = catalog[pick(rng)].instructor;
+
+    std::cout << "courses: " << options.courses << ", instructors: " << options.instructors
+              << ", queries: " << options.queries << "\n"
+              << "record bytes: owned " << sizeof(OwnedCourse) << ", interned " << sizeof(Course) << "\n";
+
+    double ownedFilter, ownedGroup;
+    std::size_t ownedBytes;
+    {
+        const std::size_t before = g_heapBytes.load();
+        std::vector<std::unique_ptr<OwnedCourse>> courses;
+        std::set<std::pair<std::string, std::int32_t>> byInstructor;
+        courses.reserve(catalog.size());
+        for (const CourseSpec& spec : catalog) {
+            courses.push_back(std::make_unique<OwnedCourse>(
+                OwnedCourse{spec.id, spec.name, spec.credits, spec.instructor, {}, 0, 0}));
+            byInstructor.insert({PrefixIndex::normalizeKey(spec.instructor), spec.id});
+        }
+        ownedBytes = g_heapBytes.load() - before;
+
+        // As the lookups did before: normalize, then compare strings.
+        ownedFilter = nsPer(queries.size(), [&] {
+            std::size_t sum = 0;
+            for (const std::string& query : queries) {
+                const std::string key = PrefixIndex::normalizeKey(query);
+                for (const auto& course : courses) sum += PrefixIndex::normalizeKey(course->m_instructor) == key;
+            }
+            g_sink = sum;
+        }) / static_cast<double>(courses.size());
+        ownedGroup = nsPer(courses.size(), [&] {
+            std::unordered_map<std::string, std::size_t> counts;
+            for (const auto& course : courses) ++counts[PrefixIndex::normalizeKey(course->m_instructor)];
+            g_sink = counts.size();
+        });
+    }
+
+    double internedFilter, internedGroup;
+    std::size_t internedBytes, poolBytes;
+    {
+        const std::size_t before = g_heapBytes.load();
+        std::vector<std::unique_ptr<Course>> courses;
+        std::set<std::pair<StringPool::Id, std::int32_t>> byInstructor;
+        courses.reserve(catalog.size());
+        for (const CourseSpec& spec : catalog) {
+            courses.push_back(std::make_unique<Course>(spec.id, spec.name, spec.credits, spec.instructor));
+            byInstructor.insert({courses.back()->instructorKey(), spec.id});
+        }
+        internedBytes = g_heapBytes.load() - before;
+        poolBytes = StringPool::instructors().memoryBytes();
+
+        internedFilter = nsPer(queries.size(), [&] {
+            std::size_t sum = 0;
+            for (const std::string& query : queries) {
+                StringPool::Id key;
+                if (!StringPool::instructors().find(PrefixIndex::normalizeKey(query), key)) continue;
+                for (const auto& course : courses) sum += course->instructorKey() == key;
+            }
+            g_sink = sum;
+        }) / static_cast<double>(courses.size());
+        internedGroup = nsPer(courses.size(), [&] {
+            std::vector<std::size_t> counts(StringPool::instructors().size());
+            for (const auto& course : courses) ++counts[course->instructorKey()];
+            g_sink = counts.size();
+        });
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "heap: owned " << mib(ownedBytes) << " MiB, interned " << mib(internedBytes) << " MiB (pool "
+              << std::setprecision(1) << static_cast<double>(poolBytes) / 1024 << " KiB), saved "
+              << std::setprecision(2) << mib(ownedBytes - std::min(ownedBytes, internedBytes)) << " MiB ("
+              << std::setprecision(1)
+              << 100.0 * (1.0 - static_cast<double>(internedBytes) / static_cast<double>(ownedBytes)) << "%)\n"
+              << std::left << std::setw(10) << "op" << std::right << std::setw(12) << "owned ns" << std::setw(14)
+              << "interned ns" << "\n"
+              << std::setprecision(2) << std::left << std::setw(10) << "filter" << std::right << std::setw(12)
+              << ownedFilter << std::setw(14) << internedFilter << "   (per course scanned)\n"
+              << std::left << std::setw(10) << "group" << std::right << std::setw(12) << ownedGroup
+              << std::setw(14) << internedGroup << "   (per course)\n";
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+#include "WriteAheadLog.h"
+
+// Throughput of a mixed enroll/drop/query workload as the thread count grows
+// from 1 to the number of hardware threads. "global" serializes every call
+// behind one mutex, the way a caller had to use EnrollmentManager before it
+// was thread-safe; "per-course" relies on the manager's own locking, and
+// "+ WAL" does the same with a write-ahead log (batched durability)
+// attached. With many courses, per-course throughput should scale with
+// cores while the global column stays flat.
+//
+// Usage: concurrency_bench [max threads] [ops per thread]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::int32_t kStudents = 20000;
+constexpr std::int32_t kCourses = 2000;
+
+template <typename Call>
+double runThreads(unsigned threads, std::size_t ops, Call&& call) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::mt19937 rng(77 + t);
+            std::uniform_int_distribution<std::int32_t> pickStudent(1, kStudents);
+            std::uniform_int_distribution<std::int32_t> pickCourse(1, kCourses);
+            std::uniform_int_distribution<int> pickOp(0, 9);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < ops; ++i) {
+                call(pickOp(rng), pickStudent(rng), pickCourse(rng));
+            }
+        });
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(threads * ops) / seconds;
+}
+
+// 50% enroll, 20% drop, 30% reads.
+void mixedOp(EnrollmentManager& manager, int op, std::int32_t studentId, std::int32_t courseId) {
+    if (op < 5) {
+        manager.enrollStudent(studentId, courseId);
+    } else if (op < 7) {
+        manager.dropStudent(studentId, courseId);
+    } else if (op < 9) {
+        manager.seatsRemaining(courseId);
+    } else {
+        manager.getCourseEnrollments(courseId);
+    }
+}
+
+enum class Mode { Global, PerCourse, Logged };
+
+double measure(unsigned threads, std::size_t ops, Mode mode) {
+    StudentRegistry students;
+    CourseRegistry courses;
+    WaitlistManager waitlists;
+    students.reserve(kStudents);
+    courses.reserve(kCourses);
+    for (std::int32_t id = 1; id <= kStudents; ++id) {
+        students.emplaceStudent(id, "Student");
+    }
+    for (std::int32_t id = 1; id <= kCourses; ++id) {
+        courses.emplaceCourse(id, "Course", 3, "Staff", std::vector<std::int32_t>{}, std::uint16_t{40});
+    }
+    EnrollmentManager manager(students, courses);
+    manager.setWaitlistManager(&waitlists);
+    manager.reserve(threads * ops);
+
+    WriteAheadLog log;
+    if (mode == Mode::Logged) {
+        const std::string path = "concurrency_bench.wal";
+        if (!log.open(path, WriteAheadLog::ReplayResult{})) {
+            std::cerr << "cannot open " << path << "\n";
+            return 0.0;
+        }
+        manager.setMutationLog(&log);
+        waitlists.setMutationLog(&log);
+    }
+
+    if (mode == Mode::Global) {
+        std::mutex global;
+        return runThreads(threads, ops, [&](int op, std::int32_t s, std::int32_t c) {
+            std::lock_guard<std::mutex> lock(global);
+            mixedOp(manager, op, s, c);
+        });
+    }
+    const double rate = runThreads(threads, ops, [&](int op, std::int32_t s, std::int32_t c) {
+        mixedOp(manager, op, s, c);
+    });
+    if (mode == Mode::Logged) {
+        log.close();
+        std::remove("concurrency_bench.wal");
+    }
+    return rate;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : hardware;
+    const std::size_t ops = argc > 2 ? static_cast<std::size_t>(std::atoll(argv[2])) : 200000;
+
+    std::cout << "hardware threads: " << hardware << ", ops per thread: " << ops << "\n";
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "global op/s" << std::setw(16) << "per-course op/s"
+              << std::setw(10) << "speedup" << std::setw(16) << "+ WAL op/s" << std::setw(10) << "speedup" << "\n";
+
+    double baseline = 0.0, loggedBaseline = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads = threads < 4 ? threads + 1 : threads * 2) {
+        const double global = measure(threads, ops, Mode::Global);
+        const double fine = measure(threads, ops, Mode::PerCourse);
+        const double logged = measure(threads, ops, Mode::Logged);
+        if (threads == 1) {
+            baseline = fine;
+            loggedBaseline = logged;
+        }
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(0) << std::setw(16) << global
+                  << std::setw(16) << fine << std::setprecision(2) << std::setw(9) << fine / baseline << "x"
+                  << std::setprecision(0) << std::setw(16) << logged << std::setprecision(2) << std::setw(9)
+                  << logged / loggedBaseline << "x\n";
+    }
+    return 0;
+}
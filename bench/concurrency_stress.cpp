@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+
+// Hammers EnrollmentManager, the registries and the waitlists from many
+// threads at once, then checks that the seat counters, the per-course and
+// per-student indexes and the columnar table all agree and that no course
+// is over capacity. Exits non-zero on any violation. Build with
+// -fsanitize=thread to also catch data races.
+//
+// Usage: concurrency_stress [threads] [ops per thread]
+
+namespace {
+
+constexpr std::int32_t kStudents = 300;
+constexpr std::int32_t kCourses = 64;
+constexpr std::uint16_t kCapacity = 20;
+constexpr std::int32_t kTransientBase = 1000000;   // ids for students added and removed mid-run
+
+std::atomic<int> g_failures{0};
+
+void check(bool condition, const char* what, std::int32_t id) {
+    if (!condition) {
+        ++g_failures;
+        std::cerr << "FAILED: " << what << " (id " << id << ")\n";
+    }
+}
+
+void worker(unsigned index, std::size_t ops, StudentRegistry& students, EnrollmentManager& manager,
+            WaitlistManager& waitlists, std::atomic<std::size_t>& successes) {
+    std::mt19937 rng(1234 + index);
+    std::uniform_int_distribution<std::int32_t> pickStudent(1, kStudents);
+    std::uniform_int_distribution<std::int32_t> pickCourse(1, kCourses);
+    std::uniform_int_distribution<int> pickOp(0, 99);
+    std::int32_t nextTransient = kTransientBase + static_cast<std::int32_t>(index) * 100000;
+
+    for (std::size_t i = 0; i < ops; ++i) {
+        const std::int32_t studentId = pickStudent(rng);
+        const std::int32_t courseId = pickCourse(rng);
+        const int op = pickOp(rng);
+        if (op < 45) {
+            if (manager.enrollStudent(studentId, courseId) == EnrollmentManager::EnrollmentResult::Success) {
+                successes.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else if (op < 65) {
+            manager.dropStudent(studentId, courseId);
+        } else if (op < 75) {
+            manager.setEnrollmentStatus(studentId, courseId, Enrollment::Status::Completed);
+        } else if (op < 80) {
+            manager.promoteFromWaitlist(courseId);
+        } else if (op < 90) {
+            const auto enrolled = manager.getCourseEnrollments(courseId);
+            check(enrolled.size() <= kCapacity, "course over capacity", courseId);
+            manager.seatsRemaining(courseId);
+            waitlists.getWaitlistSize(courseId);
+        } else if (op < 95) {
+            manager.getStudentEnrollments(studentId);
+            manager.getMissingPrerequisites(studentId, courseId);
+        } else {
+            // Registry churn: lookups on other threads must keep working.
+            const std::int32_t id = nextTransient++;
+            students.emplaceStudent(id, "Transient");
+            manager.enrollStudent(id, courseId);
+            students.removeStudent(id);
+            check(students.findStudent(id) == nullptr, "removed student still found", id);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : std::max(4u, hardware);
+    const std::size_t ops = argc > 2 ? static_cast<std::size_t>(std::atoll(argv[2])) : 50000;
+
+    StudentRegistry students;
+    CourseRegistry courses;
+    WaitlistManager waitlists;
+    for (std::int32_t id = 1; id <= kStudents; ++id) {
+        students.emplaceStudent(id, "Student");
+    }
+    // The upper half of the catalog requires the matching lower-half course.
+    for (std::int32_t id = 1; id <= kCourses; ++id) {
+        std::vector<std::int32_t> prerequisites;
+        if (id > kCourses / 2) {
+            prerequisites.push_back(id - kCourses / 2);
+        }
+        courses.emplaceCourse(id, "Course", 3, "Staff", std::move(prerequisites), kCapacity);
+    }
+
+    EnrollmentManager manager(students, courses);
+    manager.setWaitlistManager(&waitlists);
+
+    std::atomic<std::size_t> successes{0};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(worker, t, ops, std::ref(students), std::ref(manager), std::ref(waitlists),
+                          std::ref(successes));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // Quiescent invariants.
+    const auto activeByCourse = manager.countByCourse(Enrollment::Status::Active);
+    std::size_t totalActive = 0;
+    std::set<std::pair<std::int32_t, std::int32_t>> seen;
+    for (std::int32_t courseId = 1; courseId <= kCourses; ++courseId) {
+        const auto enrolled = manager.getCourseEnrollments(courseId);
+        const auto it = activeByCourse.find(courseId);
+        const std::size_t scanned = it == activeByCourse.end() ? 0 : it->second;
+        check(enrolled.size() <= kCapacity, "course over capacity", courseId);
+        check(enrolled.size() == manager.activeEnrollmentCount(courseId), "seat counter mismatch", courseId);
+        check(enrolled.size() == scanned, "table scan mismatch", courseId);
+        check(manager.seatsRemaining(courseId) == kCapacity - enrolled.size(), "seatsRemaining mismatch", courseId);
+        for (const Enrollment& e : enrolled) {
+            check(seen.emplace(e.studentId(), e.courseId()).second, "duplicate active enrollment", e.studentId());
+        }
+        totalActive += enrolled.size();
+    }
+    check(totalActive == manager.countWithStatus(Enrollment::Status::Active), "active total mismatch", 0);
+
+    // Transient students keep their enrollments after removal, so walk every
+    // student that appears in an active row.
+    std::set<std::int32_t> studentIds;
+    for (const auto& key : seen) {
+        studentIds.insert(key.first);
+    }
+    std::size_t perStudent = 0;
+    for (std::int32_t studentId : studentIds) {
+        perStudent += manager.getStudentEnrollments(studentId).size();
+    }
+    check(perStudent == totalActive, "student index mismatch", 0);
+    check(students.size() == static_cast<std::size_t>(kStudents), "registry size", 0);
+    check(students.allStudents().size() == static_cast<std::size_t>(kStudents), "registry listing", 0);
+
+    std::cout << threads << " threads x " << ops << " ops: " << successes.load() << " enrollments, "
+              << manager.enrollmentCount() << " rows, " << totalActive << " active\n";
+    if (g_failures != 0) {
+        std::cerr << g_failures.load() << " invariant violations\n";
+        return 1;
+    }
+    std::cout << "all invariants hold\n";
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "DegreePlanner.h"
+#include "BenchSupport.h"
+
+// Overnight advising batch: plans every student's path to the same degree
+// requirements and reports plans per second at 1..T threads, plus how often
+// the plan length matches its lower bound (i.e. is provably shortest).
+//
+// The catalog is `depth` levels deep; each course above level 0 needs one
+// or two courses from lower levels, mostly the level directly below, and
+// carries 1-5 credits (see bench::buildCatalog). Each student has completed
+// a course from each of the first few levels together with everything
+// those required.
+//
+// Usage: degree_planner_bench [--students=N] [--courses=M] [--depth=D]
+//                             [--targets=K] [--cap=C] [--threads=T] [--seed=X]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::int32_t students = 50000;
+    std::int32_t courses = 2000;
+    std::int32_t depth = 6;
+    std::size_t targets = 10;     // degree requirements, drawn from the upper half
+    unsigned cap = 15;            // credits per semester
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint32_t seed = 2024;
+};
+
+bool parseOption(const char* arg, Options& options) {
+    using bench::optionValue;
+    if (const char* v = optionValue(arg, "--students")) options.students = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--courses")) options.courses = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--depth")) options.depth = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--targets")) options.targets = static_cast<std::size_t>(std::max(1, std::atoi(v)));
+    else if (const char* v = optionValue(arg, "--cap")) options.cap = static_cast<unsigned>(std::max(1, std::atoi(v)));
+    else if (const char* v = optionValue(arg, "--threads")) options.threads = static_cast<unsigned>(std::max(1, std::atoi(v)));
+    else if (const char* v = optionValue(arg, "--seed")) options.seed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 10));
+    else return false;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseOption(argv[i], options)) {
+            std::cerr << "unknown option: " << argv[i] << "\n"
+                      << "usage: degree_planner_bench [--students=N] [--courses=M] [--depth=D]\n"
+                      << "                            [--targets=K] [--cap=C] [--threads=T] [--seed=X]\n";
+            return 1;
+        }
+    }
+
+    options.depth = std::min(options.depth, options.courses);
+
+    std::mt19937 rng(options.seed);
+    StudentRegistry students;
+    CourseRegistry courses;
+    EnrollmentManager manager(students, courses);
+    bench::CatalogShape shape;
+    shape.courses = options.courses;
+    shape.depth = options.depth;
+    shape.variedCredits = true;
+    shape.skipLevels = true;
+    bench::Catalog catalog = bench::buildCatalog(shape, courses, rng);
+    for (std::int32_t id = 1; id <= options.students; ++id) {
+        students.emplaceStudent(id, "Student", "s" + std::to_string(id) + "@example.edu", "555-0100", "Campus", "pw");
+    }
+    bench::buildTranscripts(catalog, options.students, static_cast<std::size_t>((options.depth + 1) / 2), courses,
+                            manager, rng);
+
+    std::vector<std::int32_t> targets;
+    while (targets.size() < options.targets) {
+        const auto level = static_cast<std::size_t>(options.depth / 2 + rng() % static_cast<std::uint32_t>((options.depth + 1) / 2));
+        const std::int32_t id = catalog.pick(level, rng);
+        if (std::find(targets.begin(), targets.end(), id) == targets.end()) {
+            targets.push_back(id);
+        }
+    }
+    std::vector<std::int32_t> studentIds(static_cast<std::size_t>(options.students));
+    for (std::size_t i = 0; i < studentIds.size(); ++i) studentIds[i] = static_cast<std::int32_t>(i + 1);
+
+    const auto buildStart = Clock::now();
+    const DegreePlanner planner(courses, manager);
+    const double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+    DegreePlanner::Options planOptions;
+    planOptions.creditCap = options.cap;
+
+    std::cout << options.students << " students, " << options.courses << " courses in " << options.depth
+              << " levels, " << options.targets << " target courses, " << options.cap << " credits/semester\n";
+    std::cout << "planner snapshot: " << std::fixed << std::setprecision(1) << buildMs << " ms\n\n";
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "seconds"
+              << std::setw(14) << "plans/s" << std::setw(12) << "us/plan" << "\n";
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < options.threads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(options.threads);
+
+    std::vector<DegreePlanner::Plan> plans;
+    for (unsigned threads : threadCounts) {
+        const auto start = Clock::now();
+        plans = planner.planBatch(studentIds, targets, planOptions, threads);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << std::left << std::setw(10) << threads << std::right << std::setprecision(3)
+                  << std::setw(12) << seconds << std::setprecision(0) << std::setw(14) << plans.size() / seconds
+                  << std::setprecision(2) << std::setw(12) << seconds * 1e6 / plans.size() * threads << "\n";
+    }
+
+    std::size_t semesters = 0, atBound = 0, blocked = 0;
+    for (const DegreePlanner::Plan& plan : plans) {
+        semesters += plan.semesters.size();
+        atBound += plan.semesters.size() == plan.lowerBound;
+        blocked += !plan.complete();
+    }
+    std::cout << "\nmean semesters: " << std::setprecision(2) << static_cast<double>(semesters) / plans.size()
+              << ", plans at their lower bound: " << std::setprecision(1) << 100.0 * atBound / plans.size()
+              << "%, incomplete plans: " << blocked << "\n";
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+
+// Measures per-operation cost of EnrollmentManager as the number of
+// enrollment rows grows. With the (student, course) index in place the
+// ns/op columns should stay roughly flat from the smallest to the largest size.
+// "batch" repeats the enroll fill through enrollBatch on a fresh manager.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nsPerOp(Clock::time_point start, Clock::time_point end, std::size_t ops) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return ops == 0 ? 0.0 : static_cast<double>(ns) / static_cast<double>(ops);
+}
+
+void runSize(std::size_t rows) {
+    constexpr std::int32_t kCourses = 1000;
+    constexpr std::int32_t kCoursesPerStudent = 8;
+    constexpr std::size_t kSampleOps = 10000;
+
+    const auto studentCount = static_cast<std::int32_t>(rows / kCoursesPerStudent);
+
+    StudentRegistry students;
+    CourseRegistry courses;
+    for (std::int32_t id = 1; id <= studentCount; ++id) {
+        students.addStudent(std::make_unique<Student>(id, "Student"));
+    }
+    for (std::int32_t id = 1; id <= kCourses; ++id) {
+        courses.addCourse(std::make_unique<Course>(id, "Course", 3, "Staff"));
+    }
+
+    EnrollmentManager manager(students, courses);
+
+    // Populate: every student takes kCoursesPerStudent distinct courses.
+    const auto fillStart = Clock::now();
+    for (std::int32_t s = 1; s <= studentCount; ++s) {
+        for (std::int32_t k = 0; k < kCoursesPerStudent; ++k) {
+            manager.enrollStudent(s, 1 + (s * 7 + k * 97) % kCourses);
+        }
+    }
+    const auto fillEnd = Clock::now();
+
+    // The same fill through enrollBatch on a fresh manager.
+    std::vector<EnrollmentManager::EnrollRequest> requests;
+    requests.reserve(rows);
+    for (std::int32_t s = 1; s <= studentCount; ++s) {
+        for (std::int32_t k = 0; k < kCoursesPerStudent; ++k) {
+            requests.emplace_back(s, 1 + (s * 7 + k * 97) % kCourses);
+        }
+    }
+    double batchNs;
+    {
+        EnrollmentManager batched(students, courses);
+        const auto batchStart = Clock::now();
+        batched.enrollBatch(requests);
+        batchNs = nsPerOp(batchStart, Clock::now(), requests.size());
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::int32_t> pickStudent(1, studentCount);
+    std::uniform_int_distribution<std::int32_t> pickCourse(1, kCourses);
+
+    // Duplicate enrollments exercise the AlreadyEnrolled lookup.
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < kSampleOps; ++i) {
+        const std::int32_t s = pickStudent(rng);
+        manager.enrollStudent(s, 1 + (s * 7) % kCourses);
+    }
+    const double duplicateNs = nsPerOp(start, Clock::now(), kSampleOps);
+
+    std::size_t touched = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < kSampleOps; ++i) {
+        touched += manager.getStudentEnrollments(pickStudent(rng)).size();
+    }
+    const double studentQueryNs = nsPerOp(start, Clock::now(), kSampleOps);
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < kSampleOps; ++i) {
+        touched += manager.getCourseEnrollments(pickCourse(rng)).size();
+    }
+    const double courseQueryNs = nsPerOp(start, Clock::now(), kSampleOps);
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < kSampleOps; ++i) {
+        const std::int32_t s = pickStudent(rng);
+        manager.dropStudent(s, 1 + (s * 7 + 97) % kCourses);
+    }
+    const double dropNs = nsPerOp(start, Clock::now(), kSampleOps);
+
+    std::cout << std::left << std::setw(12) << rows
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << nsPerOp(fillStart, fillEnd, rows)
+              << std::setw(14) << batchNs
+              << std::setw(14) << duplicateNs
+              << std::setw(14) << dropNs
+              << std::setw(16) << studentQueryNs
+              << std::setw(16) << courseQueryNs
+              << "   (" << touched << " rows read)\n";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== EnrollmentManager index benchmark (ns/op) ===\n\n";
+    std::cout << std::left << std::setw(12) << "rows"
+              << std::right
+              << std::setw(14) << "enroll"
+              << std::setw(14) << "batch"
+              << std::setw(14) << "duplicate"
+              << std::setw(14) << "drop"
+              << std::setw(16) << "byStudent"
+              << std::setw(16) << "byCourse" << "\n";
+
+    for (std::size_t rows : {10000u, 100000u, 400000u}) {
+        runSize(rows);
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "BulkImporter.h"
+
+// Generates CSV files for students, courses and enrollments and imports
+// them with BulkImporter. Pass the enrollment row count as the first
+// argument (default 1,000,000; the request target is 10,000,000).
+
+namespace {
+
+void printReport(const char* label, const BulkImporter::Report& report) {
+    std::cout << std::left << std::setw(13) << label << std::right
+              << std::setw(11) << report.rowsImported << " rows  "
+              << std::setw(6) << report.errorCount << " errors  "
+              << std::fixed << std::setprecision(2) << std::setw(8) << report.seconds << " s  "
+              << std::setprecision(0) << std::setw(12) << report.rowsPerSecond() << " rows/s\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::int64_t enrollmentRows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    const std::int32_t studentCount = static_cast<std::int32_t>(std::max<std::int64_t>(1, enrollmentRows / 5));
+    constexpr std::int32_t kCourses = 5000;
+
+    {
+        std::ofstream students("import_bench_students.csv");
+        students << "id,name,email,phone,address\n";
+        for (std::int32_t id = 1; id <= studentCount; ++id) {
+            students << id << ",Student " << id << ",s" << id << "@university.edu,555-" << id % 10000
+                     << ",\"" << id << " Campus Rd, Apt 2\"\n";
+        }
+        std::ofstream courses("import_bench_courses.csv");
+        courses << "id,name,credits,instructor,prerequisites\n";
+        for (std::int32_t id = 1; id <= kCourses; ++id) {
+            courses << id << ",Course " << id << ',' << 1 + id % 4 << ",Instructor " << id % 200 << ',';
+            if (id > 100) courses << id - 100;
+            courses << '\n';
+        }
+        std::ofstream enrollments("import_bench_enrollments.csv");
+        enrollments << "student_id,course_id,status,enrolled_at\n";
+        for (std::int64_t row = 0; row < enrollmentRows; ++row) {
+            enrollments << 1 + row % studentCount << ',' << 1 + (row * 7919 + row / studentCount * 13) % kCourses << ','
+                        << (row % 3 == 0 ? "completed" : "active") << ',' << 1700000000 + row << '\n';
+        }
+    }
+
+    StudentRegistry students;
+    CourseRegistry courses;
+    EnrollmentManager enrollments(students, courses);
+    BulkImporter importer(students, courses, enrollments);
+
+    std::cout << "=== Bulk import benchmark ===\n";
+    printReport("students", importer.importStudents("import_bench_students.csv"));
+    printReport("courses", importer.importCourses("import_bench_courses.csv"));
+    printReport("enrollments", importer.importEnrollments("import_bench_enrollments.csv"));
+
+    std::remove("import_bench_students.csv");
+    std::remove("import_bench_courses.csv");
+    std::remove("import_bench_enrollments.csv");
+    return 0;
+}
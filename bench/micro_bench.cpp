@@ -0,0 +1,392 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+
+// Google Benchmark micro-benchmarks for the core classes, each run at sizes
+// 10, 100, ... 10,000,000. Benchmarks are registered size-major, so one
+// fixture per size is built once and shared by every benchmark at that size.
+// The 10M fixtures need a few GB of memory; use --benchmark_filter to skip
+// them, e.g. --benchmark_filter='/(10|100|1000|10000|100000|1000000)$'.
+//
+// "size" is the number of students and courses in the registries, the
+// number of students on the benchmarked waitlist, and the number of
+// students in the enrollment fixture.
+
+namespace {
+
+constexpr std::int64_t kMinSize = 10;
+constexpr std::int64_t kMaxSize = 10000000;
+constexpr std::int32_t kPrerequisiteCount = 4;
+constexpr std::int32_t kCompletedStudents = 1000;   // students with a transcript, capped to keep 10M fixtures small
+constexpr std::size_t kPageSize = 100;              // rows per page in the paging benchmarks
+
+struct Fixture {
+    explicit Fixture(std::int64_t size) : size(static_cast<std::int32_t>(size)), manager(students, courses) {}
+
+    std::int32_t size;
+    StudentRegistry students;
+    CourseRegistry courses;
+    WaitlistManager waitlists;
+    EnrollmentManager manager;
+    bool registriesBuilt = false;
+    bool enrollmentsBuilt = false;
+    bool waitlistBuilt = false;
+
+    // Ids past the seeded range, used by benchmarks that add entries.
+    std::int32_t nextId() { return ++lastId; }
+    std::int32_t lastId = 0;
+
+    // Enrollment benchmark state: a course with no limit that students are
+    // enrolled into in id order; a fresh one is opened when it is full.
+    std::int32_t rushCourse = 0;
+    std::int32_t nextRushStudent = 1;
+
+    std::int32_t prerequisiteCourse() const { return size + 1; }
+    std::int32_t waitlistCourse() const { return size + 2; }
+
+    void buildRegistries() {
+        if (registriesBuilt) return;
+        students.reserve(static_cast<std::size_t>(size));
+        courses.reserve(static_cast<std::size_t>(size));
+        for (std::int32_t id = 1; id <= size; ++id) {
+            students.emplaceStudent(id, "Student");
+            courses.emplaceCourse(id, "Course", static_cast<std::uint8_t>(3), "Staff");
+        }
+        std::vector<std::int32_t> prerequisites;
+        for (std::int32_t id = 1; id <= std::min(kPrerequisiteCount, size); ++id) prerequisites.push_back(id);
+        courses.emplaceCourse(prerequisiteCourse(), "Capstone", static_cast<std::uint8_t>(3), "Staff",
+                              std::move(prerequisites));
+        courses.emplaceCourse(waitlistCourse(), "Waitlisted", static_cast<std::uint8_t>(3), "Staff");
+        lastId = waitlistCourse();
+        registriesBuilt = true;
+    }
+
+    // Even-numbered students among the first kCompletedStudents completed
+    // every prerequisite of prerequisiteCourse(); odd ones completed half.
+    void buildEnrollments() {
+        buildRegistries();
+        if (enrollmentsBuilt) return;
+        const std::int32_t transcripts = std::min(kCompletedStudents, size);
+        for (std::int32_t student = 1; student <= transcripts; ++student) {
+            const std::int32_t taken = student % 2 == 0 ? kPrerequisiteCount : kPrerequisiteCount / 2;
+            for (std::int32_t course = 1; course <= std::min(taken, size); ++course) {
+                manager.restoreEnrollment(Enrollment(student, course, Enrollment::Status::Completed));
+            }
+        }
+        enrollmentsBuilt = true;
+    }
+
+    void buildWaitlist() {
+        buildRegistries();
+        if (waitlistBuilt) return;
+        for (std::int32_t student = 1; student <= size; ++student) {
+            waitlists.addToWaitlist(waitlistCourse(), student);
+        }
+        waitlistBuilt = true;
+    }
+};
+
+// One fixture alive at a time keeps the 10M runs within memory.
+Fixture& fixtureFor(std::int64_t size) {
+    static std::unique_ptr<Fixture> fixture;
+    if (!fixture || fixture->size != size) {
+        fixture.reset();
+        fixture = std::make_unique<Fixture>(size);
+    }
+    return *fixture;
+}
+
+std::vector<std::int32_t> randomIds(std::int32_t size, std::size_t count = 4096) {
+    std::mt19937 rng(static_cast<std::uint32_t>(size));
+    std::uniform_int_distribution<std::int32_t> pick(1, size);
+    std::vector<std::int32_t> ids(count);
+    for (auto& id : ids) id = pick(rng);
+    return ids;
+}
+
+// --- StudentRegistry -------------------------------------------------------
+
+void StudentRegistry_addStudent(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    std::vector<std::int32_t> added;
+    for (auto _ : state) {
+        const std::int32_t id = f.nextId();
+        benchmark::DoNotOptimize(f.students.addStudent(std::make_unique<Student>(id, "Student")));
+        added.push_back(id);
+    }
+    for (std::int32_t id : added) f.students.removeStudent(id);
+}
+
+void StudentRegistry_findStudent(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.students.findStudent(ids[i++ & (ids.size() - 1)]));
+    }
+}
+
+void StudentRegistry_allStudents(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.students.allStudents());
+    }
+    state.SetItemsProcessed(state.iterations() * f.size);
+}
+
+// One page of kPageSize students after a random id, walked in id order.
+void StudentRegistry_page(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        for (const Student& student : f.students.page(ids[i++ & (ids.size() - 1)], kPageSize)) {
+            benchmark::DoNotOptimize(student.id());
+        }
+    }
+}
+
+// --- CourseRegistry --------------------------------------------------------
+
+void CourseRegistry_addCourse(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    std::vector<std::int32_t> added;
+    for (auto _ : state) {
+        const std::int32_t id = f.nextId();
+        benchmark::DoNotOptimize(f.courses.addCourse(
+            std::make_unique<Course>(id, "Course", static_cast<std::uint8_t>(3), "Staff")));
+        added.push_back(id);
+    }
+    for (std::int32_t id : added) f.courses.removeCourse(id);
+}
+
+void CourseRegistry_findCourse(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.courses.findCourse(ids[i++ & (ids.size() - 1)]));
+    }
+}
+
+void CourseRegistry_allCourses(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.courses.allCourses());
+    }
+    state.SetItemsProcessed(state.iterations() * f.size);
+}
+
+void CourseRegistry_page(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildRegistries();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        for (const Course& course : f.courses.page(ids[i++ & (ids.size() - 1)], kPageSize)) {
+            benchmark::DoNotOptimize(course.id());
+        }
+    }
+}
+
+// --- EnrollmentManager -----------------------------------------------------
+
+void EnrollmentManager_enrollStudent(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildEnrollments();
+    for (auto _ : state) {
+        if (f.rushCourse == 0 || f.nextRushStudent > f.size) {
+            state.PauseTiming();
+            f.rushCourse = f.nextId();
+            f.courses.emplaceCourse(f.rushCourse, "Rush", static_cast<std::uint8_t>(3), "Staff");
+            f.nextRushStudent = 1;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(f.manager.enrollStudent(f.nextRushStudent++, f.rushCourse));
+    }
+}
+
+void EnrollmentManager_enrollStudentDuplicate(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildEnrollments();
+    // Completed rows are not active, so enroll one student actively first.
+    f.manager.enrollStudent(1, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.manager.enrollStudent(1, 1));
+    }
+}
+
+void EnrollmentManager_hasPrerequisites(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildEnrollments();
+    const auto ids = randomIds(std::min(kCompletedStudents, f.size));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.manager.hasPrerequisites(ids[i++ & (ids.size() - 1)], f.prerequisiteCourse()));
+    }
+}
+
+void EnrollmentManager_getMissingPrerequisites(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildEnrollments();
+    const auto ids = randomIds(std::min(kCompletedStudents, f.size));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            f.manager.getMissingPrerequisites(ids[i++ & (ids.size() - 1)], f.prerequisiteCourse()));
+    }
+}
+
+// --- WaitlistManager -------------------------------------------------------
+// The waitlist for waitlistCourse() holds `size` students; every benchmark
+// leaves it that size.
+
+void WaitlistManager_addToWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    std::vector<std::int32_t> added;
+    for (auto _ : state) {
+        const std::int32_t id = f.nextId();
+        benchmark::DoNotOptimize(f.waitlists.addToWaitlist(f.waitlistCourse(), id));
+        added.push_back(id);
+    }
+    for (std::int32_t id : added) f.waitlists.removeFromWaitlist(f.waitlistCourse(), id);
+}
+
+// Pops the front student and queues them again at the back.
+void WaitlistManager_getNextFromWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    for (auto _ : state) {
+        const std::int32_t id = f.waitlists.getNextFromWaitlist(f.waitlistCourse());
+        f.waitlists.addToWaitlist(f.waitlistCourse(), id);
+    }
+}
+
+// Removes a random student and queues them again at the back.
+void WaitlistManager_removeFromWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const std::int32_t id = ids[i++ & (ids.size() - 1)];
+        f.waitlists.removeFromWaitlist(f.waitlistCourse(), id);
+        f.waitlists.addToWaitlist(f.waitlistCourse(), id);
+    }
+}
+
+void WaitlistManager_isOnWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.isOnWaitlist(f.waitlistCourse(), ids[i++ & (ids.size() - 1)]));
+    }
+}
+
+void WaitlistManager_getWaitlistPosition(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    const auto ids = randomIds(f.size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.getWaitlistPosition(f.waitlistCourse(), ids[i++ & (ids.size() - 1)]));
+    }
+}
+
+void WaitlistManager_getWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.getWaitlist(f.waitlistCourse()));
+    }
+    state.SetItemsProcessed(state.iterations() * f.size);
+}
+
+void WaitlistManager_findWaitlist(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.findWaitlist(f.waitlistCourse()));
+    }
+}
+
+void WaitlistManager_getWaitlistSize(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.getWaitlistSize(f.waitlistCourse()));
+    }
+}
+
+void WaitlistManager_isWaitlistEmpty(benchmark::State& state) {
+    Fixture& f = fixtureFor(state.range(0));
+    f.buildWaitlist();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.waitlists.isWaitlistEmpty(f.waitlistCourse()));
+    }
+}
+
+struct Entry {
+    const char* name;
+    void (*fn)(benchmark::State&);
+};
+
+// Benchmarks that add entries run after the listing ones, whose cost would
+// otherwise include the slots freed behind them.
+const Entry kBenchmarks[] = {
+    {"StudentRegistry/findStudent", StudentRegistry_findStudent},
+    {"StudentRegistry/allStudents", StudentRegistry_allStudents},
+    {"StudentRegistry/page", StudentRegistry_page},
+    {"StudentRegistry/addStudent", StudentRegistry_addStudent},
+    {"CourseRegistry/findCourse", CourseRegistry_findCourse},
+    {"CourseRegistry/allCourses", CourseRegistry_allCourses},
+    {"CourseRegistry/page", CourseRegistry_page},
+    {"CourseRegistry/addCourse", CourseRegistry_addCourse},
+    {"EnrollmentManager/enrollStudent", EnrollmentManager_enrollStudent},
+    {"EnrollmentManager/enrollStudentDuplicate", EnrollmentManager_enrollStudentDuplicate},
+    {"EnrollmentManager/hasPrerequisites", EnrollmentManager_hasPrerequisites},
+    {"EnrollmentManager/getMissingPrerequisites", EnrollmentManager_getMissingPrerequisites},
+    {"WaitlistManager/addToWaitlist", WaitlistManager_addToWaitlist},
+    {"WaitlistManager/getNextFromWaitlist", WaitlistManager_getNextFromWaitlist},
+    {"WaitlistManager/removeFromWaitlist", WaitlistManager_removeFromWaitlist},
+    {"WaitlistManager/isOnWaitlist", WaitlistManager_isOnWaitlist},
+    {"WaitlistManager/getWaitlistPosition", WaitlistManager_getWaitlistPosition},
+    {"WaitlistManager/getWaitlist", WaitlistManager_getWaitlist},
+    {"WaitlistManager/findWaitlist", WaitlistManager_findWaitlist},
+    {"WaitlistManager/getWaitlistSize", WaitlistManager_getWaitlistSize},
+    {"WaitlistManager/isWaitlistEmpty", WaitlistManager_isWaitlistEmpty},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (std::int64_t size = kMinSize; size <= kMaxSize; size *= 10) {
+        for (const Entry& entry : kBenchmarks) {
+            benchmark::RegisterBenchmark(entry.name, entry.fn)->Arg(size);
+        }
+    }
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
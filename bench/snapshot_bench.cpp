@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Snapshot.h"
+
+// Saves and reloads a synthetic catalog of 1M students, 10k courses,
+// 1M enrollments and a few thousand waitlist entries through Snapshot.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string path = argc > 1 ? argv[1] : "snapshot_bench.snap";
+    constexpr std::int32_t kStudents = 1000000;
+    constexpr std::int32_t kCourses = 10000;
+
+    StudentRegistry students;
+    CourseRegistry courses;
+    EnrollmentManager enrollments(students, courses);
+    WaitlistManager waitlists;
+
+    auto start = Clock::now();
+    students.reserve(kStudents);
+    for (std::int32_t id = 1; id <= kStudents; ++id) {
+        const std::string tag = std::to_string(id);
+        students.addStudent(std::make_unique<Student>(id, "Student " + tag, "s" + tag + "@university.edu",
+                                                      "555-" + tag, tag + " Campus Rd"));
+    }
+    courses.reserve(kCourses);
+    for (std::int32_t id = 1; id <= kCourses; ++id) {
+        std::vector<std::int32_t> prereqs;
+        if (id > 100) prereqs.push_back(id - 100);
+        courses.addCourse(std::make_unique<Course>(id, "Course " + std::to_string(id), 3,
+                                                   "Instructor " + std::to_string(id % 300), prereqs));
+    }
+    enrollments.reserve(kStudents);
+    for (std::int32_t id = 1; id <= kStudents; ++id) {
+        enrollments.enrollStudent(id, 1 + id % 100);
+    }
+    for (std::int32_t id = 1; id <= 5000; ++id) {
+        waitlists.addToWaitlist(1 + id % 50, id);
+    }
+    std::cout << "Built catalog in " << std::fixed << std::setprecision(1) << msSince(start) << " ms\n";
+
+    start = Clock::now();
+    auto status = Snapshot::save(path, students, courses, enrollments, waitlists);
+    const double saveMs = msSince(start);
+    if (status != Snapshot::Status::Ok) {
+        std::cerr << "save failed: " << Snapshot::describe(status) << "\n";
+        return 1;
+    }
+
+    StudentRegistry loadedStudents;
+    CourseRegistry loadedCourses;
+    EnrollmentManager loadedEnrollments(loadedStudents, loadedCourses);
+    WaitlistManager loadedWaitlists;
+
+    start = Clock::now();
+    status = Snapshot::load(path, loadedStudents, loadedCourses, loadedEnrollments, loadedWaitlists);
+    const double loadMs = msSince(start);
+    if (status != Snapshot::Status::Ok) {
+        std::cerr << "load failed: " << Snapshot::describe(status) << "\n";
+        return 1;
+    }
+
+    std::cout << "Save: " << saveMs << " ms\n";
+    std::cout << "Load: " << loadMs << " ms ("
+              << loadedStudents.size() << " students, "
+              << loadedCourses.size() << " courses, "
+              << loadedEnrollments.enrollmentCount() << " enrollments)\n";
+
+    std::remove(path.c_str());
+    return 0;
+}
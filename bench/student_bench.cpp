@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+#include "BenchSupport.h"
+
+// Registration-rush simulator.
+//
+// Synthesizes a catalog whose courses form a prerequisite DAG `depth` levels
+// deep, gives every student a transcript of completed lower-level courses,
+// and then replays a rush of enroll/drop/complete/waitlist traffic against
+// EnrollmentManager and WaitlistManager. Course popularity is Zipf-skewed,
+// so a handful of sections are hammered while the tail stays quiet. Reports
+// overall throughput and p50/p99/p999 latency for each operation.
+//
+// Usage: student_bench [--students=N] [--courses=M] [--depth=D] [--zipf=S]
+//                      [--capacity=C] [--ops=K] [--threads=T] [--seed=X]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::int32_t students = 50000;
+    std::int32_t courses = 2000;
+    std::int32_t depth = 4;           // prerequisite chain length, in levels
+    double zipf = 1.1;                // popularity skew; 0 is uniform
+    std::uint16_t capacity = 60;
+    std::size_t ops = 1000000;        // per thread
+    unsigned threads = 1;
+    std::uint32_t seed = 2024;
+};
+
+bool parseOption(const char* arg, Options& options) {
+    using bench::optionValue;
+    if (const char* v = optionValue(arg, "--students")) options.students = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--courses")) options.courses = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--depth")) options.depth = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--zipf")) options.zipf = std::max(0.0, std::atof(v));
+    else if (const char* v = optionValue(arg, "--capacity")) options.capacity = static_cast<std::uint16_t>(std::atoi(v));
+    else if (const char* v = optionValue(arg, "--ops")) options.ops = std::strtoull(v, nullptr, 10);
+    else if (const char* v = optionValue(arg, "--threads")) options.threads = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--seed")) options.seed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 10));
+    else return false;
+    return true;
+}
+
+enum Op : std::size_t { Enroll, Drop, Complete, WaitlistCheck, SeatQuery, CourseRoster, kOpCount };
+constexpr std::array<const char*, kOpCount> kOpNames = {
+    "enroll", "drop", "complete", "waitlist", "seats", "roster"};
+// Percent of the rush spent on each operation, in Op order.
+constexpr std::array<int, kOpCount> kOpMix = {60, 8, 2, 10, 12, 8};
+
+struct ThreadResult {
+    std::array<std::vector<std::uint32_t>, kOpCount> latencies;   // ns
+    std::array<std::size_t, kOpCount> successes{};
+    std::size_t waitlisted = 0;
+};
+
+void runRush(const Options& options, unsigned index, const bench::Catalog& catalog, EnrollmentManager& manager,
+             WaitlistManager& waitlists, ThreadResult& out) {
+    std::mt19937 rng(options.seed + 1 + index);
+    std::discrete_distribution<std::int32_t> pickCourse(catalog.popularity.begin(), catalog.popularity.end());
+    std::uniform_int_distribution<std::int32_t> pickStudent(1, options.students);
+    std::discrete_distribution<std::size_t> pickOp(kOpMix.begin(), kOpMix.end());
+
+    for (auto& samples : out.latencies) samples.reserve(options.ops / 2);
+    // Enrollments this thread made, so drops and completions hit real rows.
+    std::vector<std::pair<std::int32_t, std::int32_t>> mine;
+
+    for (std::size_t i = 0; i < options.ops; ++i) {
+        std::size_t op = pickOp(rng);
+        if ((op == Drop || op == Complete) && mine.empty()) op = Enroll;
+
+        const std::int32_t courseId = pickCourse(rng) + 1;
+        const std::int32_t studentId = pickStudent(rng);
+        std::size_t slot = 0;
+        if (op == Drop || op == Complete) {
+            slot = rng() % mine.size();
+        }
+
+        bool ok = false;
+        const auto start = Clock::now();
+        switch (op) {
+        case Enroll: {
+            const auto result = manager.enrollStudent(studentId, courseId);
+            ok = result == EnrollmentManager::EnrollmentResult::Success;
+            if (result == EnrollmentManager::EnrollmentResult::CourseFull) ++out.waitlisted;
+            break;
+        }
+        case Drop:
+            ok = manager.dropStudent(mine[slot].first, mine[slot].second);
+            break;
+        case Complete:
+            ok = manager.setEnrollmentStatus(mine[slot].first, mine[slot].second, Enrollment::Status::Completed);
+            break;
+        case WaitlistCheck:
+            ok = waitlists.getWaitlistPosition(courseId, studentId) != 0;
+            break;
+        case SeatQuery:
+            ok = manager.seatsRemaining(courseId) > 0;
+            break;
+        case CourseRoster:
+            ok = !manager.getCourseEnrollments(courseId).empty();
+            break;
+        }
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        out.latencies[op].push_back(static_cast<std::uint32_t>(std::min<std::int64_t>(ns, UINT32_MAX)));
+
+        if (ok) ++out.successes[op];
+        if (op == Enroll && ok) {
+            mine.emplace_back(studentId, courseId);
+        } else if (op == Drop || op == Complete) {
+            mine[slot] = mine.back();
+            mine.pop_back();
+        }
+    }
+}
+
+double percentile(const std::vector<std::uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+    return static_cast<double>(sorted[index]);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseOption(argv[i], options)) {
+            std::cerr << "unknown option: " << argv[i] << "\n"
+                      << "usage: student_bench [--students=N] [--courses=M] [--depth=D] [--zipf=S]\n"
+                      << "                     [--capacity=C] [--ops=K] [--threads=T] [--seed=X]\n";
+            return 2;
+        }
+    }
+    options.depth = std::min(options.depth, options.courses);
+
+    std::mt19937 rng(options.seed);
+    StudentRegistry students;
+    CourseRegistry courses;
+    WaitlistManager waitlists;
+    students.reserve(static_cast<std::size_t>(options.students));
+    courses.reserve(static_cast<std::size_t>(options.courses));
+    for (std::int32_t id = 1; id <= options.students; ++id) {
+        students.emplaceStudent(id, "Student " + std::to_string(id));
+    }
+    bench::CatalogShape shape;
+    shape.courses = options.courses;
+    shape.depth = options.depth;
+    shape.zipf = options.zipf;
+    shape.capacity = options.capacity;
+    bench::Catalog catalog = bench::buildCatalog(shape, courses, rng);
+
+    EnrollmentManager manager(students, courses);
+    manager.setWaitlistManager(&waitlists);
+    const auto setupStart = Clock::now();
+    bench::buildTranscripts(catalog, options.students, static_cast<std::size_t>(options.depth - 1), courses, manager, rng);
+    const double setupSeconds = std::chrono::duration<double>(Clock::now() - setupStart).count();
+
+    std::cout << "=== Registration rush ===\n"
+              << options.students << " students, " << options.courses << " courses in " << options.depth
+              << " prerequisite levels, capacity " << options.capacity << ", zipf " << options.zipf << "\n"
+              << manager.enrollmentCount() << " transcript rows built in " << std::fixed << std::setprecision(2)
+              << setupSeconds << " s\n"
+              << options.threads << " thread(s) x " << options.ops << " ops\n\n";
+
+    std::vector<ThreadResult> results(options.threads);
+    std::vector<std::thread> pool;
+    const auto start = Clock::now();
+    for (unsigned t = 0; t < options.threads; ++t) {
+        pool.emplace_back(runRush, std::cref(options), t, std::cref(catalog), std::ref(manager),
+                          std::ref(waitlists), std::ref(results[t]));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::left << std::setw(10) << "op" << std::right << std::setw(10) << "count" << std::setw(10)
+              << "ok %" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(11) << "p999 ns"
+              << std::setw(11) << "max ns" << "\n";
+    std::size_t waitlisted = 0;
+    for (const auto& r : results) waitlisted += r.waitlisted;
+    for (std::size_t op = 0; op < kOpCount; ++op) {
+        std::vector<std::uint32_t> samples;
+        std::size_t successes = 0;
+        for (const auto& r : results) {
+            samples.insert(samples.end(), r.latencies[op].begin(), r.latencies[op].end());
+            successes += r.successes[op];
+        }
+        std::sort(samples.begin(), samples.end());
+        const double okPercent = samples.empty() ? 0.0 : 100.0 * static_cast<double>(successes) /
+                                                             static_cast<double>(samples.size());
+        std::cout << std::left << std::setw(10) << kOpNames[op] << std::right << std::setw(10) << samples.size()
+                  << std::setprecision(1) << std::setw(10) << okPercent << std::setprecision(0)
+                  << std::setw(10) << percentile(samples, 0.50) << std::setw(10) << percentile(samples, 0.99)
+                  << std::setw(11) << percentile(samples, 0.999)
+                  << std::setw(11) << (samples.empty() ? 0.0 : static_cast<double>(samples.back())) << "\n";
+    }
+
+    const double totalOps = static_cast<double>(options.ops) * options.threads;
+    std::cout << "\nthroughput: " << std::setprecision(0) << totalOps / seconds << " ops/s ("
+              << std::setprecision(3) << seconds << " s)\n"
+              << "course-full results: " << waitlisted << ", rows at end: " << manager.enrollmentCount() << "\n";
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ConcurrentIdMap.h"
+#include "ObjectPool.h"
+#include "Student.h"
+#include "BenchSupport.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hot/cold Student layout benchmark.
+//
+// Stores the same synthetic students twice, once in the old layout with all
+// six fields inline and once as Student (id and name inline, contact data in
+// a separate profile), each in an ObjectPool behind a ConcurrentIdMap the
+// way StudentRegistry keeps them. Then runs the access patterns of the hot
+// paths against both:
+//
+//   validate  random id -> record, read the id (enrollment checks)
+//   name      random id -> record, read the name (rosters, search results)
+//   scan      every record in pool order, read id and name (listings)
+//
+// Reports ns per access and, where the kernel allows perf events, hardware
+// cache misses per access; the 64-byte lines each record spans are printed
+// too, as the miss count a scan cannot avoid. With more students than fit
+// in the last-level cache the split layout touches about a third of the
+// memory.
+//
+// Usage: student_layout_bench [--students=N] [--lookups=K] [--seed=X]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::int32_t students = 1000000;
+    std::size_t lookups = 5000000;
+    std::uint32_t seed = 2024;
+};
+
+bool parseOption(const char* arg, Options& options) {
+    using bench::optionValue;
+    if (const char* v = optionValue(arg, "--students")) options.students = std::max(1, std::atoi(v));
+    else if (const char* v = optionValue(arg, "--lookups")) options.lookups = std::strtoull(v, nullptr, 10);
+    else if (const char* v = optionValue(arg, "--seed")) options.seed = static_cast<std::uint32_t>(std::strtoul(v, nullptr, 10));
+    else return false;
+    return true;
+}
+
+// Student as it was before the split: every field inline.
+struct InlineStudent {
+    InlineStudent(std::int32_t id, std::string name, std::string email, std::string phone, std::string address,
+                  std::string password)
+        : m_id(id), m_name(std::move(name)), m_email(std::move(email)), m_phone(std::move(phone)),
+          m_address(std::move(address)), m_password(std::move(password)) {}
+
+    std::int32_t id() const noexcept { return m_id; }
+    const std::string& name() const noexcept { return m_name; }
+
+    std::int32_t m_id;
+    std::string m_name;
+    std::string m_email;
+    std::string m_phone;
+    std::string m_address;
+    std::string m_password;
+};
+
+template <typename T>
+struct Table {
+    ObjectPool<T> pool;
+    ConcurrentIdMap index;
+
+    const T* find(std::int32_t id) const {
+        std::uint32_t handle;
+        return index.find(id, handle) ? pool.get(handle) : nullptr;
+    }
+};
+
+template <typename T>
+void fill(Table<T>& table, std::int32_t students) {
+    table.pool.reserve(static_cast<std::size_t>(students));
+    table.index.reserve(static_cast<std::size_t>(students));
+    for (std::int32_t id = 1; id <= students; ++id) {
+        const std::string n = std::to_string(id);
+        table.index.insert(id, table.pool.create(id, "Student " + n, "student" + n + "@university.edu",
+                                                 "+1-555-" + n, n + " University Avenue, Springfield",
+                                                 "correct-horse-battery-" + n));
+    }
+}
+
+// Hardware cache-miss counter for the calling thread; reads -1 if perf
+// events are unavailable (non-Linux, or perf_event_paranoid too strict).
+class MissCounter {
+public:
+    MissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~MissCounter() {
+#ifdef __linux__
+        if (m_fd >= 0) close(m_fd);
+#endif
+    }
+    MissCounter(const MissCounter&) = delete;
+    MissCounter& operator=(const MissCounter&) = delete;
+
+    void start() {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    long long stop() {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = 0;
+            if (read(m_fd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) return count;
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+struct Result {
+    double nsPerAccess = 0.0;
+    double missesPerAccess = -1.0;
+};
+
+template <typename Fn>
+Result measure(std::size_t accesses, MissCounter& misses, Fn&& fn) {
+    misses.start();
+    const auto start = Clock::now();
+    fn();
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    const long long missCount = misses.stop();
+    Result result;
+    result.nsPerAccess = ns / static_cast<double>(accesses);
+    if (missCount >= 0) result.missesPerAccess = static_cast<double>(missCount) / static_cast<double>(accesses);
+    return result;
+}
+
+volatile std::size_t g_sink;   // keeps the loops from being optimized away
+
+template <typename T>
+std::vector<Result> run(const Table<T>& table, const std::vector<std::int32_t>& ids, MissCounter& misses) {
+    std::vector<Result> results;
+    results.push_back(measure(ids.size(), misses, [&] {
+        std::size_t sum = 0;
+        for (std::int32_t id : ids) sum += static_cast<std::size_t>(table.find(id)->id());
+        g_sink = sum;
+    }));
+    results.push_back(measure(ids.size(), misses, [&] {
+        std::size_t sum = 0;
+        for (std::int32_t id : ids) sum += table.find(id)->name().size();
+        g_sink = sum;
+    }));
+    results.push_back(measure(table.pool.size(), misses, [&] {
+        std::size_t sum = 0;
+        table.pool.forEach([&](const T& student) {
+            sum += static_cast<std::size_t>(student.id()) + student.name().size();
+        });
+        g_sink = sum;
+    }));
+    return results;
+}
+
+std::string format(double value, int precision) {
+    if (value < 0) return "n/a";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << value;
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseOption(argv[i], options)) {
+            std::cerr << "unknown option: " << argv[i] << "\n"
+                      << "usage: student_layout_bench [--students=N] [--lookups=K] [--seed=X]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "students: " << options.students << ", lookups: " << options.lookups << "\n"
+              << "record bytes: inline " << sizeof(InlineStudent) << ", split " << sizeof(Student)
+              << " (hot table " << (sizeof(InlineStudent) * static_cast<std::size_t>(options.students)) / (1 << 20)
+              << " MiB -> " << (sizeof(Student) * static_cast<std::size_t>(options.students)) / (1 << 20)
+              << " MiB)\n"
+              << "cache lines per scanned record: inline " << std::fixed << std::setprecision(2)
+              << sizeof(InlineStudent) / 64.0 << ", split " << sizeof(Student) / 64.0 << "\n";
+
+    std::mt19937 rng(options.seed);
+    std::uniform_int_distribution<std::int32_t> pick(1, options.students);
+    std::vector<std::int32_t> ids(options.lookups);
+    for (std::int32_t& id : ids) id = pick(rng);
+
+    MissCounter misses;
+    std::vector<Result> before, after;
+    {
+        Table<InlineStudent> table;
+        fill(table, options.students);
+        before = run(table, ids, misses);
+    }
+    {
+        Table<Student> table;
+        fill(table, options.students);
+        after = run(table, ids, misses);
+    }
+
+    const char* names[] = {"validate", "name", "scan"};
+    std::cout << std::left << std::setw(10) << "access" << std::right << std::setw(12) << "inline ns"
+              << std::setw(12) << "split ns" << std::setw(14) << "inline miss" << std::setw(14) << "split miss"
+              << "\n";
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        std::cout << std::left << std::setw(10) << names[i] << std::right << std::setw(12)
+                  << format(before[i].nsPerAccess, 1) << std::setw(12) << format(after[i].nsPerAccess, 1)
+                  << std::setw(14) << format(before[i].missesPerAccess, 3) << std::setw(14)
+                  << format(after[i].missesPerAccess, 3) << "\n";
+    }
+    if (before.front().missesPerAccess < 0) {
+        std::cout << "(cache misses unavailable: perf events not permitted here)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "BackgroundWorker.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <optional>
+
+float BackgroundWorker::Progress::fraction() const noexcept {
+    const std::size_t total = m_total.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return -1.0f;
+    }
+    const std::size_t done = std::min(m_done.load(std::memory_order_relaxed), total);
+    return static_cast<float>(static_cast<double>(done) / static_cast<double>(total));
+}
+
+BackgroundWorker::BackgroundWorker() : m_thread(&BackgroundWorker::workerLoop, this) {}
+
+BackgroundWorker::~BackgroundWorker() {
+    stop();
+}
+
+std::shared_ptr<const BackgroundWorker::Progress> BackgroundWorker::submit(std::string label, Job job) {
+    auto progress = std::make_shared<Progress>(std::move(label));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({progress, std::move(job)});
+    }
+    m_wake.notify_one();
+    return progress;
+}
+
+std::size_t BackgroundWorker::poll() {
+    std::size_t delivered = 0;
+    while (std::optional<Done> done = m_done.pop()) {
+        if (done->completion && !done->progress->cancelled()) {
+            done->completion();
+        }
+        if (done->progress->m_state.load(std::memory_order_relaxed) != Progress::State::Failed) {
+            done->progress->m_state.store(Progress::State::Finished, std::memory_order_release);
+        }
+        ++delivered;
+    }
+    return delivered;
+}
+
+void BackgroundWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_stopping = true;
+        m_jobs.clear();
+        if (m_running) {
+            m_running->cancel();
+        }
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    while (m_done.pop()) {
+    }
+}
+
+void BackgroundWorker::workerLoop() {
+    for (;;) {
+        Queued next;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            next = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_running = next.progress;
+        }
+        next.progress->m_state.store(Progress::State::Running, std::memory_order_release);
+        Done done{next.progress, nullptr};
+        try {
+            done.completion = next.job(*next.progress);
+        } catch (const std::exception& e) {
+            next.progress->m_error = e.what();
+            next.progress->m_state.store(Progress::State::Failed, std::memory_order_release);
+        } catch (...) {
+            next.progress->m_error = "unknown error";
+            next.progress->m_state.store(Progress::State::Failed, std::memory_order_release);
+        }
+
+        // The UI drains the queue every frame; if it is full, wait for a slot.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_running.reset();
+        while (!m_stopping && !m_done.push(std::move(done))) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        if (m_stopping) {
+            return;
+        }
+    }
+}
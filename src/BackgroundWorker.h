@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SpscQueue.h"
+#include "VersionCounter.h"
+
+// Runs slow jobs (imports, report and table building) on one background
+// thread so the thread that draws the UI never waits for them.
+//
+// A job reports how far it has got through its Progress, which the UI reads
+// each frame to draw a progress bar. When done it returns a completion; the
+// worker hands that back through a lock-free SpscQueue and the UI thread
+// runs it from poll(). Results are therefore published into UI state on the
+// UI thread only, with no locks shared between the two threads.
+//
+// Jobs run one at a time, in submission order. They may read the core
+// classes while the UI thread uses them too (both are thread-safe); wrap a
+// multi-step read in readConsistent() for a result taken from a single
+// state of the data.
+//
+// A job that throws fails: its Progress reports the error and no completion
+// runs. Cancellation is cooperative: cancel() only raises a flag that long
+// jobs poll through Progress::cancelled() between steps, and the completion
+// of a cancelled job is dropped.
+class BackgroundWorker final {
+public:
+    class Progress {
+    public:
+        explicit Progress(std::string label) : m_label(std::move(label)) {}
+
+        const std::string& label() const noexcept { return m_label; }
+        // Done fraction in [0, 1]; negative until the job reports a total.
+        float fraction() const noexcept;
+        bool running() const noexcept { return m_state.load(std::memory_order_acquire) == State::Running; }
+        // True once the job is over and, if it succeeded, its completion has
+        // run on the UI thread.
+        bool finished() const noexcept { return m_state.load(std::memory_order_acquire) >= State::Finished; }
+        // True if the job threw; error() then holds what it threw. Set
+        // before finished() turns true.
+        bool failed() const noexcept { return m_state.load(std::memory_order_acquire) == State::Failed; }
+        const std::string& error() const noexcept { return m_error; }
+
+        // Asks the job to stop early. Any thread may call it.
+        void cancel() const noexcept { m_cancelled.store(true, std::memory_order_relaxed); }
+        bool cancelled() const noexcept { return m_cancelled.load(std::memory_order_relaxed); }
+
+        // Called by the job.
+        void setTotal(std::size_t total) noexcept { m_total.store(total, std::memory_order_relaxed); }
+        void setDone(std::size_t done) noexcept { m_done.store(done, std::memory_order_relaxed); }
+
+    private:
+        friend class BackgroundWorker;
+        enum class State { Queued, Running, Finished, Failed };
+
+        const std::string m_label;
+        std::string m_error;   // written by the worker before m_state becomes Failed
+        std::atomic<std::size_t> m_done{0};
+        std::atomic<std::size_t> m_total{0};
+        std::atomic<State> m_state{State::Queued};
+        mutable std::atomic<bool> m_cancelled{false};
+    };
+
+    using Completion = std::function<void()>;
+    using Job = std::function<Completion(Progress&)>;
+
+    // Completions the worker can hand over before it waits for poll().
+    static constexpr std::size_t kCompletionSlots = 64;
+
+    BackgroundWorker();
+    ~BackgroundWorker();
+
+    BackgroundWorker(const BackgroundWorker&) = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+    // Queues `job`. The returned Progress stays valid while it is held.
+    std::shared_ptr<const Progress> submit(std::string label, Job job);
+
+    // Runs the completions of jobs that have finished since the last call and
+    // returns how many. Call from the UI thread (only), once per frame.
+    std::size_t poll();
+
+    // Cancels the running job and waits for it to return, then drops queued
+    // jobs and undelivered completions. Call before destroying anything the
+    // jobs refer to.
+    void stop();
+
+private:
+    struct Queued {
+        std::shared_ptr<Progress> progress;
+        Job job;
+    };
+    struct Done {
+        std::shared_ptr<Progress> progress;
+        Completion completion;
+    };
+
+    void workerLoop();
+
+    std::mutex m_mutex;   // guards m_jobs, m_running and m_stopping
+    std::condition_variable m_wake;
+    std::deque<Queued> m_jobs;
+    std::shared_ptr<Progress> m_running;   // progress of the job being run, if any
+    bool m_stopping = false;
+    SpscQueue<Done> m_done{kCompletionSlots};
+    std::thread m_thread;
+};
+
+// Calls build() until the value returned by versions() (an array of the
+// core classes' version() counters) reads the same before and after it with
+// no change under way, so build() saw a single state of the data. Waits for
+// changes in progress to finish before building, and backs off briefly
+// between attempts while writers keep running. Returns true once a build
+// was consistent, or false if the job was cancelled first.
+template <typename Versions, typename Build>
+bool readConsistent(Versions&& versions, Build&& build, const BackgroundWorker::Progress& progress) {
+    for (;;) {
+        const auto before = versions();
+        if (std::find(before.begin(), before.end(), VersionCounter::kChanging) == before.end()) {
+            build();
+            if (versions() == before) {
+                return true;
+            }
+        }
+        if (progress.cancelled()) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Word-level bit helpers shared by the bitmap-based indexes.
+
+inline unsigned popCount(std::uint64_t word) noexcept {
+#ifdef _MSC_VER
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#else
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+}
+
+// Index of the lowest set bit; `word` must be non-zero.
+inline unsigned lowestBit(std::uint64_t word) noexcept {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+// Index of the highest set bit; `word` must be non-zero.
+inline unsigned highestBit(std::uint64_t word) noexcept {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(word));
+#endif
+}
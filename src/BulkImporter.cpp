@@ -0,0 +1,523 @@
+#include "BulkImporter.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+constexpr std::size_t kChunkBytes = 4 << 20;
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+template <typename T>
+bool parseInt(std::string_view text, T& value) {
+    text = trim(text);
+    if (text.empty()) return false;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return (x | 0x20) == (y | 0x20);
+           });
+}
+
+bool parseStatus(std::string_view text, Enrollment::Status& status) {
+    text = trim(text);
+    if (text.empty() || equalsIgnoreCase(text, "active")) { status = Enrollment::Status::Active; return true; }
+    if (equalsIgnoreCase(text, "completed")) { status = Enrollment::Status::Completed; return true; }
+    if (equalsIgnoreCase(text, "dropped")) { status = Enrollment::Status::Dropped; return true; }
+    if (equalsIgnoreCase(text, "withdrawn")) { status = Enrollment::Status::Withdrawn; return true; }
+    return false;
+}
+
+// Finds the newline that ends the record starting at `begin`: the first
+// one outside a quoted field, so quoted fields may span lines. Returns
+// nullptr if the record may continue past `end` (the rest of the file when
+// `atEof`), and counts the newlines inside quoted fields in `embedded`.
+const char* findRecordEnd(const char* begin, const char* end, char delimiter, bool atEof, std::size_t& embedded) {
+    embedded = 0;
+    const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+    if (newline && !std::memchr(begin, '"', static_cast<std::size_t>(newline - begin))) {
+        return newline;
+    }
+    bool fieldStart = true;
+    bool quoted = false;
+    for (const char* p = begin; p < end; ++p) {
+        if (quoted) {
+            if (*p == '\n') {
+                ++embedded;
+            } else if (*p == '"') {
+                if (p + 1 == end && !atEof) return nullptr;   // "" or a closing quote; needs the next byte
+                if (p + 1 < end && p[1] == '"') ++p;
+                else quoted = false;
+            }
+        } else if (*p == '\n') {
+            return p;
+        } else if (*p == delimiter) {
+            fieldStart = true;
+        } else if (*p == '"' && fieldStart) {
+            quoted = true;
+            fieldStart = false;
+        } else if (*p != ' ') {
+            fieldStart = false;
+        }
+    }
+    return nullptr;
+}
+
+// Splits one record into fields in place. Quoted fields are unescaped by
+// compacting them inside the record buffer, so every field is a view into
+// it. Returns false if a quoted field is never closed.
+bool splitFields(char* line, std::size_t length, char delimiter, std::vector<std::string_view>& fields) {
+    fields.clear();
+    char* pos = line;
+    char* const end = line + length;
+    for (;;) {
+        while (pos < end && *pos == ' ') ++pos;
+        if (pos < end && *pos == '"') {
+            char* out = ++pos;
+            char* const start = out;
+            bool closed = false;
+            while (pos < end) {
+                if (*pos == '"') {
+                    if (pos + 1 < end && pos[1] == '"') { *out++ = '"'; pos += 2; continue; }
+                    ++pos;
+                    closed = true;
+                    break;
+                }
+                *out++ = *pos++;
+            }
+            if (!closed) return false;
+            fields.emplace_back(start, static_cast<std::size_t>(out - start));
+            while (pos < end && *pos != delimiter) ++pos;   // ignore anything after the closing quote
+        } else {
+            char* const start = pos;
+            while (pos < end && *pos != delimiter) ++pos;
+            fields.push_back(trim(std::string_view(start, static_cast<std::size_t>(pos - start))));
+        }
+        if (pos >= end) break;
+        ++pos;   // skip delimiter
+    }
+    return true;
+}
+
+// A header row names its columns: every field starts with a letter and
+// holds only letters, digits, spaces, '_' and '-' ("id", "Student ID",
+// "enrolled_at"). Data rows carry numeric ids, so they never qualify.
+bool isHeader(const std::vector<std::string_view>& fields) {
+    auto isLetter = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); };
+    return std::all_of(fields.begin(), fields.end(), [&](std::string_view name) {
+        return !name.empty() && isLetter(name.front()) &&
+               std::all_of(name.begin(), name.end(), [&](char c) {
+                   return isLetter(c) || (c >= '0' && c <= '9') || c == ' ' || c == '_' || c == '-';
+               });
+    });
+}
+
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+} // namespace
+
+BulkImporter::BulkImporter(StudentRegistry& students, CourseRegistry& courses, EnrollmentManager& enrollments)
+    : m_students(students), m_courses(courses), m_enrollments(enrollments) {}
+
+BulkImporter::Report BulkImporter::importStudents(const std::string& path) {
+    return run(path, Kind::Students);
+}
+
+BulkImporter::Report BulkImporter::importCourses(const std::string& path) {
+    return run(path, Kind::Courses);
+}
+
+BulkImporter::Report BulkImporter::importEnrollments(const std::string& path) {
+    return run(path, Kind::Enrollments);
+}
+
+BulkImporter::Report BulkImporter::run(const std::string& path, Kind kind) {
+    Report report;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.c_str(), "rb"));
+    if (!file) {
+        return report;
+    }
+    report.fileOpened = true;
+
+    std::fseek(file.get(), 0, SEEK_END);
+    const long fileSize = std::ftell(file.get());
+    std::fseek(file.get(), 0, SEEK_SET);
+
+    std::vector<char> buffer(kChunkBytes);
+    std::vector<std::string_view> fields;
+    std::string error;
+    std::size_t carried = 0;       // bytes of an incomplete record kept from the previous chunk
+    std::size_t lineNumber = 0;
+    std::size_t bytesRead = 0;
+    char delimiter = 0;
+    bool headerChecked = false;
+    bool reserved = false;
+    bool eof = false;
+
+    while (!eof) {
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2);   // a single record longer than the chunk
+        }
+        const std::size_t got = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file.get());
+        eof = got < buffer.size() - carried;
+        const std::size_t filled = carried + got;
+        bytesRead += got;
+
+        char* const base = buffer.data();
+        std::size_t lineStart = 0;
+        std::size_t linesInChunk = 0;
+        for (;;) {
+            if (delimiter == 0) {
+                const void* newline = std::memchr(base + lineStart, '\n', filled - lineStart);
+                if (!newline && !eof) break;
+                const std::size_t firstLine = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - base)
+                                                      : filled;
+                delimiter = std::memchr(base + lineStart, '\t', firstLine - lineStart) ? '\t' : ',';
+            }
+            std::size_t embedded = 0;
+            const char* newline = findRecordEnd(base + lineStart, base + filled, delimiter, eof, embedded);
+            if (!newline && !(eof && lineStart < filled)) {
+                break;
+            }
+            const std::size_t lineEnd = newline ? static_cast<std::size_t>(newline - base) : filled;
+            char* line = base + lineStart;
+            std::size_t length = lineEnd - lineStart;
+            lineStart = newline ? lineEnd + 1 : filled;
+            const std::size_t recordLine = ++lineNumber;
+            lineNumber += embedded;
+            ++linesInChunk;
+
+            if (length > 0 && line[length - 1] == '\r') --length;
+            if (trim(std::string_view(line, length)).empty()) continue;
+
+            const bool complete = splitFields(line, length, delimiter, fields);
+            if (!headerChecked) {
+                headerChecked = true;
+                if (complete && isHeader(fields)) continue;
+            }
+
+            ++report.rowsRead;
+            if (!complete) {
+                error = "unterminated quoted field";
+            } else if (importRow(kind, recordLine, fields, error)) {
+                ++report.rowsImported;
+                continue;
+            }
+            if (report.errors.size() < kMaxStoredErrors) {
+                report.errors.push_back({recordLine, error});
+            }
+            ++report.errorCount;
+        }
+
+        // Size the target containers once, from the first chunk's average line length.
+        if (!reserved && linesInChunk > 0 && fileSize > 0) {
+            const std::size_t bytesPerLine = std::max<std::size_t>(1, lineStart / linesInChunk);
+            reserveFor(kind, static_cast<std::size_t>(fileSize) / bytesPerLine);
+            reserved = true;
+        }
+        addPendingRows(kind, report);
+
+        carried = filled - lineStart;
+        std::memmove(base, base + lineStart, carried);
+        if (m_progress && !m_progress(bytesRead, fileSize > 0 ? static_cast<std::size_t>(fileSize) : bytesRead)) {
+            report.cancelled = true;
+            break;
+        }
+    }
+
+    if (kind == Kind::Courses) {
+        importDeferredCourses(report);
+    }
+    // Batched and held-back rows are rejected after the rows that follow them.
+    std::stable_sort(report.errors.begin(), report.errors.end(),
+                     [](const RowError& a, const RowError& b) { return a.line < b.line; });
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+bool BulkImporter::importRow(Kind kind, std::size_t line, const std::vector<std::string_view>& fields,
+                             std::string& error) {
+    switch (kind) {
+        case Kind::Students: return importStudent(line, fields, error);
+        case Kind::Courses: return importCourse(line, fields, error);
+        case Kind::Enrollments: return importEnrollment(fields, error);
+    }
+    return false;
+}
+
+bool BulkImporter::importStudent(std::size_t line, const std::vector<std::string_view>& fields, std::string& error) {
+    std::int32_t id = 0;
+    if (fields.size() < 2 || fields.size() > 6) {
+        error = "expected 2-6 fields: id, name, email, phone, address, password";
+        return false;
+    }
+    if (!parseInt(fields[0], id)) {
+        error = "invalid student id";
+        return false;
+    }
+    if (fields[1].empty()) {
+        error = "missing name";
+        return false;
+    }
+
+    // Counted as imported for now; addPendingRows() settles it.
+    auto field = [&](std::size_t i) { return i < fields.size() ? std::string(fields[i]) : std::string(); };
+    m_pendingStudents.emplace_back(id, field(1), field(2), field(3), field(4), field(5));
+    m_pendingLines.push_back(line);
+    return true;
+}
+
+bool BulkImporter::importCourse(std::size_t line, const std::vector<std::string_view>& fields, std::string& error) {
+    std::int32_t id = 0;
+    unsigned credits = 0;
+    unsigned capacity = Course::kUnlimitedCapacity;
+    if (fields.size() < 4 || fields.size() > 6) {
+        error = "expected 4-6 fields: id, name, credits, instructor, prerequisites, capacity";
+        return false;
+    }
+    if (!parseInt(fields[0], id)) {
+        error = "invalid course id";
+        return false;
+    }
+    if (!parseInt(fields[2], credits) || credits > 255) {
+        error = "invalid credits";
+        return false;
+    }
+
+    std::vector<std::int32_t> prerequisites;
+    if (fields.size() == 6 && !trim(fields[5]).empty() &&
+        (!parseInt(fields[5], capacity) || capacity >= Course::kUnlimitedCapacity)) {
+        error = "invalid capacity";
+        return false;
+    }
+
+    if (fields.size() >= 5) {
+        std::string_view rest = fields[4];
+        while (!rest.empty()) {
+            const std::size_t cut = rest.find_first_of("; ");
+            const std::string_view item = rest.substr(0, cut);
+            rest = cut == std::string_view::npos ? std::string_view() : rest.substr(cut + 1);
+            if (trim(item).empty()) continue;
+            std::int32_t prereq = 0;
+            if (!parseInt(item, prereq)) {
+                error = "invalid prerequisite id";
+                return false;
+            }
+            prerequisites.push_back(prereq);
+        }
+    }
+
+    // Counted as imported for now; addPendingRows() settles it.
+    m_pendingCourses.emplace_back(id, std::string(fields[1]), static_cast<std::uint8_t>(credits),
+                                  std::string(fields[3]), std::move(prerequisites),
+                                  static_cast<std::uint16_t>(capacity));
+    m_pendingLines.push_back(line);
+    return true;
+}
+
+// Adds the chunk's parsed rows in one registry batch, so the registry
+// locks once per chunk rather than once per row. Courses whose
+// prerequisites are not registered yet are held back for
+// importDeferredCourses().
+void BulkImporter::addPendingRows(Kind kind, Report& report) {
+    if (kind == Kind::Students && !m_pendingStudents.empty()) {
+        const std::vector<StudentRegistry::AddResult> results = m_students.addStudents(m_pendingStudents);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Student& row = m_pendingStudents[i];
+            if (results[i] == StudentRegistry::AddResult::IdTaken) {
+                rejectRow(report, m_pendingLines[i], "duplicate student id " + std::to_string(row.id()));
+            } else if (results[i] == StudentRegistry::AddResult::EmailTaken) {
+                rejectRow(report, m_pendingLines[i], "duplicate email " + row.email());
+            }
+        }
+    } else if (kind == Kind::Courses && !m_pendingCourses.empty()) {
+        const std::vector<PrerequisiteGraph::Result> results = m_courses.addCourses(m_pendingCourses);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            Course& row = m_pendingCourses[i];
+            switch (results[i]) {
+                case PrerequisiteGraph::Result::Ok:
+                    break;
+                case PrerequisiteGraph::Result::UnknownPrerequisite:
+                    m_deferredCourses.push_back({m_pendingLines[i], std::move(row)});
+                    break;
+                case PrerequisiteGraph::Result::Cycle:
+                    rejectRow(report, m_pendingLines[i],
+                              "prerequisites of course " + std::to_string(row.id()) + " form a cycle");
+                    break;
+                default:
+                    rejectRow(report, m_pendingLines[i], "duplicate course id " + std::to_string(row.id()));
+                    break;
+            }
+        }
+    }
+    m_pendingStudents.clear();
+    m_pendingCourses.clear();
+    m_pendingLines.clear();
+}
+
+void BulkImporter::rejectRow(Report& report, std::size_t line, std::string message) {
+    --report.rowsImported;
+    if (report.errors.size() < kMaxStoredErrors) {
+        report.errors.push_back({line, std::move(message)});
+    }
+    ++report.errorCount;
+}
+
+void BulkImporter::importDeferredCourses(Report& report) {
+
+    // Kahn's algorithm over the held-back rows: each row counts the
+    // prerequisites it is still missing and waits under each of their ids;
+    // adding a course releases the rows waiting for it, so every row and
+    // edge is looked at a constant number of times.
+    const PrerequisiteGraph& graph = m_courses.prerequisiteGraph();
+    std::vector<std::size_t> missing(m_deferredCourses.size(), 0);
+    std::unordered_map<std::int32_t, std::vector<std::size_t>> waitingFor;
+    std::vector<std::size_t> ready;
+    for (std::size_t i = 0; i < m_deferredCourses.size(); ++i) {
+        const std::vector<std::int32_t>& prerequisites = m_deferredCourses[i].course.prerequisites();
+        for (std::size_t k = 0; k < prerequisites.size(); ++k) {
+            const std::int32_t prereq = prerequisites[k];
+            const bool repeated =
+                std::find(prerequisites.begin(), prerequisites.begin() + k, prereq) != prerequisites.begin() + k;
+            if (repeated || graph.contains(prereq)) continue;
+            ++missing[i];
+            waitingFor[prereq].push_back(i);
+        }
+        if (missing[i] == 0) ready.push_back(i);
+    }
+
+    std::vector<bool> settled(m_deferredCourses.size(), false);
+    for (std::size_t next = 0; next < ready.size(); ++next) {
+        const std::size_t i = ready[next];
+        settled[i] = true;
+        DeferredCourse& row = m_deferredCourses[i];
+        const std::int32_t id = row.course.id();
+        const PrerequisiteGraph::Result result = m_courses.checkPrerequisites(id, row.course.prerequisites());
+        if (result == PrerequisiteGraph::Result::Cycle) {
+            rejectRow(report, row.line, "prerequisites of course " + std::to_string(id) + " form a cycle");
+            continue;
+        }
+        if (result == PrerequisiteGraph::Result::UnknownPrerequisite) {
+            // A prerequisite that was there when counted has been removed since.
+            rejectRow(report, row.line, "unknown prerequisite for course " + std::to_string(id));
+            continue;
+        }
+        if (!m_courses.emplaceCourse(std::move(row.course))) {
+            rejectRow(report, row.line, "duplicate course id " + std::to_string(id));
+            continue;
+        }
+        const auto waiting = waitingFor.find(id);
+        if (waiting == waitingFor.end()) continue;
+        for (std::size_t j : waiting->second) {
+            if (--missing[j] == 0) ready.push_back(j);
+        }
+        waitingFor.erase(waiting);
+    }
+
+    // What is left depends, directly or through other leftover rows, on a
+    // course that is nowhere in the file; any other leftover is in a cycle.
+    // Mark the rows missing a course no leftover row provides, then spread
+    // the mark along waitingFor.
+    std::unordered_set<std::int32_t> leftover;
+    for (std::size_t i = 0; i < m_deferredCourses.size(); ++i) {
+        if (!settled[i]) leftover.insert(m_deferredCourses[i].course.id());
+    }
+    std::vector<bool> dangling(m_deferredCourses.size(), false);
+    std::vector<std::size_t> spread;
+    for (const auto& [prereq, rows] : waitingFor) {
+        if (leftover.count(prereq) != 0) continue;
+        for (std::size_t i : rows) {
+            if (!dangling[i]) {
+                dangling[i] = true;
+                spread.push_back(i);
+            }
+        }
+    }
+    for (std::size_t next = 0; next < spread.size(); ++next) {
+        const auto waiting = waitingFor.find(m_deferredCourses[spread[next]].course.id());
+        if (waiting == waitingFor.end()) continue;
+        for (std::size_t j : waiting->second) {
+            if (!dangling[j]) {
+                dangling[j] = true;
+                spread.push_back(j);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < m_deferredCourses.size(); ++i) {
+        if (settled[i]) continue;
+        const std::int32_t id = m_deferredCourses[i].course.id();
+        rejectRow(report, m_deferredCourses[i].line,
+                  dangling[i] ? "unknown prerequisite for course " + std::to_string(id)
+                              : "prerequisites of course " + std::to_string(id) + " form a cycle");
+    }
+    m_deferredCourses.clear();
+}
+
+bool BulkImporter::importEnrollment(const std::vector<std::string_view>& fields, std::string& error) {
+    std::int32_t studentId = 0, courseId = 0;
+    Enrollment::Status status = Enrollment::Status::Active;
+    if (fields.size() < 2 || fields.size() > 4) {
+        error = "expected 2-4 fields: student_id, course_id, status, enrolled_at";
+        return false;
+    }
+    if (!parseInt(fields[0], studentId) || !parseInt(fields[1], courseId)) {
+        error = "invalid student or course id";
+        return false;
+    }
+    if (fields.size() >= 3 && !parseStatus(fields[2], status)) {
+        error = "invalid status";
+        return false;
+    }
+
+    auto enrolledAt = std::chrono::system_clock::now();
+    if (fields.size() == 4 && !trim(fields[3]).empty()) {
+        std::int64_t seconds = 0;
+        if (!parseInt(fields[3], seconds)) {
+            error = "invalid enrolled_at";
+            return false;
+        }
+        enrolledAt = std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+    }
+
+    if (!m_students.findStudent(studentId)) {
+        error = "unknown student " + std::to_string(studentId);
+        return false;
+    }
+    if (!m_courses.findCourse(courseId)) {
+        error = "unknown course " + std::to_string(courseId);
+        return false;
+    }
+    if (!m_enrollments.restoreEnrollment(Enrollment(studentId, courseId, status, enrolledAt))) {
+        error = "student already actively enrolled in this course";
+        return false;
+    }
+    return true;
+}
+
+void BulkImporter::reserveFor(Kind kind, std::size_t rows) {
+    switch (kind) {
+        case Kind::Students: m_students.reserve(m_students.size() + rows); break;
+        case Kind::Courses: m_courses.reserve(m_courses.size() + rows); break;
+        case Kind::Enrollments: m_enrollments.reserve(m_enrollments.enrollmentCount() + rows); break;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+
+// Streaming CSV/TSV importer for students, courses and enrollments.
+//
+// Files are read in large chunks and split into string_view fields in place;
+// only values that end up stored in a Student or Course are copied. The
+// delimiter (comma or tab) is taken from the first line. A first row whose
+// fields are all column names (a letter, then letters, digits, spaces, '_'
+// or '-') is a header and skipped; any other first row is data. Fields may
+// be double-quoted ("a, b" or "say ""hi""") and quoted fields may span
+// lines; a quote still open at the end of the file makes that row an
+// error. Bad rows are reported with the line they start on and skipped;
+// the import carries on.
+//
+// Expected columns:
+//   students:     id, name, email, phone, address[, password]
+//   courses:      id, name, credits, instructor[, prerequisites[, capacity]]
+//                 prerequisites are course ids separated by ';' or spaces,
+//                 capacity is a seat limit (empty = unlimited, 0 = closed)
+//   enrollments:  student_id, course_id[, status[, enrolled_at]]
+//                 status is active|completed|dropped|withdrawn (default active),
+//                 enrolled_at is Unix time in seconds (default now)
+//
+// A course may list prerequisites defined further down the file; such rows
+// are held back and added once the file has been read. Rows whose
+// prerequisites are still unknown then, or would form a cycle, are errors.
+//
+// Enrollment rows are historical records: they must reference an existing
+// student and course, but prerequisites are not re-checked.
+class BulkImporter {
+public:
+    struct RowError {
+        std::size_t line;
+        std::string message;
+    };
+
+    struct Report {
+        std::size_t rowsRead = 0;
+        std::size_t rowsImported = 0;
+        std::size_t errorCount = 0;
+        std::vector<RowError> errors;   // up to kMaxStoredErrors of errorCount, by line
+        double seconds = 0.0;
+        bool fileOpened = false;
+        bool cancelled = false;   // the progress callback stopped the import
+
+        double rowsPerSecond() const noexcept { return seconds > 0.0 ? rowsRead / seconds : 0.0; }
+    };
+
+    static constexpr std::size_t kMaxStoredErrors = 1000;
+
+    // Called after each chunk with the bytes read so far and the file size.
+    // Returning false stops the import there: rows already read stay
+    // imported and the report is marked cancelled.
+    using ProgressCallback = std::function<bool(std::size_t bytesRead, std::size_t fileBytes)>;
+
+    BulkImporter(StudentRegistry& students, CourseRegistry& courses, EnrollmentManager& enrollments);
+
+    void setProgressCallback(ProgressCallback callback) { m_progress = std::move(callback); }
+
+    Report importStudents(const std::string& path);
+    Report importCourses(const std::string& path);
+    Report importEnrollments(const std::string& path);
+
+private:
+    enum class Kind { Students, Courses, Enrollments };
+
+    Report run(const std::string& path, Kind kind);
+    struct DeferredCourse {
+        std::size_t line;
+        Course course;
+    };
+
+    bool importRow(Kind kind, std::size_t line, const std::vector<std::string_view>& fields, std::string& error);
+    bool importStudent(std::size_t line, const std::vector<std::string_view>& fields, std::string& error);
+    bool importCourse(std::size_t line, const std::vector<std::string_view>& fields, std::string& error);
+    void addPendingRows(Kind kind, Report& report);
+    void importDeferredCourses(Report& report);
+    void rejectRow(Report& report, std::size_t line, std::string message);
+    bool importEnrollment(const std::vector<std::string_view>& fields, std::string& error);
+    void reserveFor(Kind kind, std::size_t rows);
+
+    StudentRegistry& m_students;
+    CourseRegistry& m_courses;
+    EnrollmentManager& m_enrollments;
+    std::vector<Student> m_pendingStudents;          // parsed rows of the current chunk, not yet added
+    std::vector<Course> m_pendingCourses;
+    std::vector<std::size_t> m_pendingLines;         // line of each pending row
+    std::vector<DeferredCourse> m_deferredCourses;   // course rows waiting for their prerequisites
+    ProgressCallback m_progress;
+};
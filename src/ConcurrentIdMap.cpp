@@ -0,0 +1,148 @@
+#include "ConcurrentIdMap.h"
+#include <algorithm>
+#include "Epoch.h"
+
+namespace {
+
+// Slot encoding: key in the high half, value + 1 in the low half, so a live
+// entry is never 0 (empty) or all ones (tombstone).
+constexpr std::uint64_t kEmpty = 0;
+constexpr std::uint64_t kTombstone = ~std::uint64_t{0};
+constexpr std::size_t kMinCapacity = 16;
+
+inline std::uint64_t encode(std::int32_t key, std::uint32_t value) noexcept {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) << 32) | (value + 1u);
+}
+
+inline std::int32_t keyOf(std::uint64_t slot) noexcept {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(slot >> 32));
+}
+
+inline std::uint32_t valueOf(std::uint64_t slot) noexcept {
+    return static_cast<std::uint32_t>(slot) - 1u;
+}
+
+inline std::size_t hashOf(std::int32_t key) noexcept {
+    std::uint64_t h = static_cast<std::uint32_t>(key) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+std::size_t capacityFor(std::size_t entries) {
+    std::size_t capacity = kMinCapacity;
+    while (capacity < entries * 2) capacity <<= 1;   // keep the load factor at or below 1/2
+    return capacity;
+}
+
+} // namespace
+
+ConcurrentIdMap::Table::Table(std::size_t capacity)
+    : mask(capacity - 1), slots(new std::atomic<std::uint64_t>[capacity]) {
+    for (std::size_t i = 0; i < capacity; ++i) {
+        slots[i].store(kEmpty, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentIdMap::ConcurrentIdMap() : m_table(new Table(kMinCapacity)) {}
+
+ConcurrentIdMap::~ConcurrentIdMap() {
+    delete m_table.load(std::memory_order_relaxed);
+    for (auto& [stamp, table] : m_retired) {
+        delete table;
+    }
+}
+
+bool ConcurrentIdMap::find(std::int32_t key, std::uint32_t& value) const noexcept {
+    const Table* table = m_table.load(std::memory_order_acquire);
+    for (std::size_t i = hashOf(key);; ++i) {
+        const std::uint64_t slot = table->slots[i & table->mask].load(std::memory_order_acquire);
+        if (slot == kEmpty) {
+            return false;
+        }
+        if (slot != kTombstone && keyOf(slot) == key) {
+            value = valueOf(slot);
+            return true;
+        }
+    }
+}
+
+bool ConcurrentIdMap::insert(std::int32_t key, std::uint32_t value) {
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if ((table->used + 1) * 2 > table->mask + 1) {
+        rehash(capacityFor(size() + 1));
+        table = m_table.load(std::memory_order_relaxed);
+    }
+
+    std::size_t target = SIZE_MAX;
+    for (std::size_t i = hashOf(key);; ++i) {
+        const std::size_t index = i & table->mask;
+        const std::uint64_t slot = table->slots[index].load(std::memory_order_relaxed);
+        if (slot == kEmpty) {
+            if (target == SIZE_MAX) {
+                target = index;
+                ++table->used;
+            }
+            break;
+        }
+        if (slot == kTombstone) {
+            if (target == SIZE_MAX) target = index;
+        } else if (keyOf(slot) == key) {
+            return false;
+        }
+    }
+    table->slots[target].store(encode(key, value), std::memory_order_release);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentIdMap::erase(std::int32_t key, std::uint32_t* value) {
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (std::size_t i = hashOf(key);; ++i) {
+        auto& cell = table->slots[i & table->mask];
+        const std::uint64_t slot = cell.load(std::memory_order_relaxed);
+        if (slot == kEmpty) {
+            return false;
+        }
+        if (slot != kTombstone && keyOf(slot) == key) {
+            if (value) *value = valueOf(slot);
+            cell.store(kTombstone, std::memory_order_release);
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+void ConcurrentIdMap::reserve(std::size_t count) {
+    const Table* table = m_table.load(std::memory_order_relaxed);
+    if (capacityFor(count) > table->mask + 1) {
+        rehash(capacityFor(count));
+    }
+}
+
+void ConcurrentIdMap::rehash(std::size_t capacity) {
+    Table* old = m_table.load(std::memory_order_relaxed);
+    auto fresh = std::make_unique<Table>(std::max(capacity, kMinCapacity));
+    for (std::size_t i = 0; i <= old->mask; ++i) {
+        const std::uint64_t slot = old->slots[i].load(std::memory_order_relaxed);
+        if (slot == kEmpty || slot == kTombstone) continue;
+        for (std::size_t j = hashOf(keyOf(slot));; ++j) {
+            auto& cell = fresh->slots[j & fresh->mask];
+            if (cell.load(std::memory_order_relaxed) == kEmpty) {
+                cell.store(slot, std::memory_order_relaxed);
+                ++fresh->used;
+                break;
+            }
+        }
+    }
+    m_table.store(fresh.release(), std::memory_order_release);
+    m_retired.emplace_back(Epoch::retire(), old);
+    reclaimTables();
+}
+
+void ConcurrentIdMap::reclaimTables() {
+    auto it = m_retired.begin();
+    while (it != m_retired.end() && Epoch::isReclaimable(it->first)) {
+        delete it->second;
+        ++it;
+    }
+    m_retired.erase(m_retired.begin(), it);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Hash map from an int32 id to a uint32 value (a pool handle) whose lookups
+// are lock-free and never block writers.
+//
+// Open addressing with linear probing; each slot is one atomic 64-bit word
+// holding the key and value, so a reader sees either a whole entry or none.
+// Writers must be serialized by the caller. Growing builds a new table and
+// publishes it with one pointer swap; the old table is retired through
+// Epoch and freed once no reader can still be probing it. Readers must hold
+// an Epoch::Guard across find().
+class ConcurrentIdMap final {
+public:
+    ConcurrentIdMap();
+    ~ConcurrentIdMap();
+
+    ConcurrentIdMap(const ConcurrentIdMap&) = delete;
+    ConcurrentIdMap& operator=(const ConcurrentIdMap&) = delete;
+
+    // Reader side.
+    bool find(std::int32_t key, std::uint32_t& value) const noexcept;
+    std::size_t size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+    // Writer side. `value` must be below UINT32_MAX - 1.
+    bool insert(std::int32_t key, std::uint32_t value);
+    bool erase(std::int32_t key, std::uint32_t* value = nullptr);
+    void reserve(std::size_t count);
+
+private:
+    struct Table {
+        explicit Table(std::size_t capacity);
+        std::size_t mask;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+        std::size_t used = 0;   // live entries plus tombstones
+    };
+
+    void rehash(std::size_t capacity);
+    void reclaimTables();
+
+    std::atomic<Table*> m_table;
+    std::atomic<std::size_t> m_size{0};
+    std::vector<std::pair<std::uint64_t, Table*>> m_retired;   // (epoch stamp, table)
+};
@@ -1,12 +1,34 @@
 #include "Course.h"
+#include <atomic>
+#include "PrefixIndex.h"
 
 Course::Course(std::int32_t id,
                std::string name,
                std::uint8_t credits,
-               std::string instructor,
-               std::vector<std::int32_t> prerequisites)
+               std::string_view instructor,
+               std::vector<std::int32_t> prerequisites,
+               std::uint16_t capacity)
     : m_id(id),
       m_name(std::move(name)),
       m_credits(credits),
-      m_instructor(std::move(instructor)),
-      m_prerequisites(std::move(prerequisites)) {} 
\ No newline at end of file
+      m_prerequisites(std::move(prerequisites)),
+      m_prerequisitesStamp(nextPrerequisitesStamp()),
+      m_capacity(capacity) {
+    setInstructor(instructor);
+}
+
+void Course::setInstructor(std::string_view instructor) {
+    StringPool& pool = StringPool::instructors();
+    m_instructor = pool.intern(instructor);
+    m_instructorKey = pool.intern(PrefixIndex::normalizeKey(instructor));
+}
+
+void Course::setPrerequisites(std::vector<std::int32_t> pre) {
+    m_prerequisites = std::move(pre);
+    m_prerequisitesStamp = nextPrerequisitesStamp();
+}
+
+std::uint64_t Course::nextPrerequisitesStamp() noexcept {
+    static std::atomic<std::uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+} 
\ No newline at end of file
@@ -1,34 +1,80 @@
 #pragma once
 
+#include <atomic>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <vector>
+#include "StringPool.h"
 
+// Instructor names repeat across many sections, so a course holds them as
+// ids in StringPool::instructors() rather than as owned strings: equal
+// names have equal instructorId()s, and names equal up to case and
+// surrounding whitespace have equal instructorKey()s, which is what
+// grouping by instructor compares.
 class Course final {
 public:
     Course(std::int32_t id,
            std::string name,
            std::uint8_t credits,
-           std::string instructor,
-           std::vector<std::int32_t> prerequisites = {});
+           std::string_view instructor,
+           std::vector<std::int32_t> prerequisites = {},
+           std::uint16_t capacity = kUnlimitedCapacity);
+
+    // Capacity value meaning the course has no seat limit. A capacity of 0
+    // is a closed course: every request goes to the waitlist.
+    static constexpr std::uint16_t kUnlimitedCapacity = std::numeric_limits<std::uint16_t>::max();
 
     // Immutable getters
     std::int32_t id() const noexcept { return m_id; }
     const std::string &name() const noexcept { return m_name; }
     std::uint8_t credits() const noexcept { return m_credits; }
-    const std::string &instructor() const noexcept { return m_instructor; }
+    std::string_view instructor() const noexcept { return StringPool::instructors().view(m_instructor); }
+    StringPool::Id instructorId() const noexcept { return m_instructor; }
+    // Id of the instructor name lowercased and trimmed (see PrefixIndex::normalizeKey).
+    StringPool::Id instructorKey() const noexcept { return m_instructorKey; }
     const std::vector<std::int32_t> &prerequisites() const noexcept { return m_prerequisites; }
+    std::uint16_t capacity() const noexcept { return m_capacity.value.load(std::memory_order_relaxed); }
+    bool hasCapacityLimit() const noexcept { return capacity() != kUnlimitedCapacity; }
+
+    // Changes every time the prerequisite list is replaced and is never reused
+    // for a different list, so caches derived from prerequisites() can be
+    // validated with a single compare.
+    std::uint64_t prerequisitesStamp() const noexcept { return m_prerequisitesStamp; }
 
-    // Mutators
+    // Mutators. For a registered course use CourseRegistry's setters for
+    // name, credits and instructor, which keep its indexes in sync.
     void setName(std::string name) { m_name = std::move(name); }
     void setCredits(std::uint8_t credits) { m_credits = credits; }
-    void setInstructor(std::string instructor) { m_instructor = std::move(instructor); }
-    void setPrerequisites(std::vector<std::int32_t> pre) { m_prerequisites = std::move(pre); }
+    void setInstructor(std::string_view instructor);
+    // For a registered course use CourseRegistry::setPrerequisites, which
+    // validates the list and keeps the prerequisite graph in sync.
+    void setPrerequisites(std::vector<std::int32_t> pre);
+    // For a registered course use EnrollmentManager::setCapacity, which
+    // takes the course lock, logs the change and fills freed seats.
+    void setCapacity(std::uint16_t capacity) { m_capacity.value.store(capacity, std::memory_order_relaxed); }
 
 private:
     std::int32_t m_id;
     std::string m_name;
     std::uint8_t m_credits;
-    std::string m_instructor;
+    StringPool::Id m_instructor;
+    StringPool::Id m_instructorKey;
     std::vector<std::int32_t> m_prerequisites;
+    std::uint64_t m_prerequisitesStamp;
+    // Seat queries read the capacity without the course lock, so it is
+    // atomic; copying a Course copies the current value.
+    struct Capacity {
+        std::atomic<std::uint16_t> value;
+        explicit Capacity(std::uint16_t initial) noexcept : value(initial) {}
+        Capacity(const Capacity& other) noexcept : value(other.value.load(std::memory_order_relaxed)) {}
+        Capacity& operator=(const Capacity& other) noexcept {
+            value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+    Capacity m_capacity;
+
+    static std::uint64_t nextPrerequisitesStamp() noexcept;
 }; 
\ No newline at end of file
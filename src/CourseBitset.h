@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Dense bitset addressed by compacted course index (see EnrollmentManager).
+// Grows on demand; bits past the stored words read as zero, so sets of
+// different lengths can be compared directly.
+class CourseBitset final {
+public:
+    void set(std::size_t index) {
+        const std::size_t word = index / kBitsPerWord;
+        if (word >= m_words.size()) {
+            m_words.resize(word + 1, 0);
+        }
+        m_words[word] |= std::uint64_t{1} << (index % kBitsPerWord);
+    }
+
+    bool test(std::size_t index) const noexcept {
+        const std::size_t word = index / kBitsPerWord;
+        return word < m_words.size() &&
+               (m_words[word] >> (index % kBitsPerWord)) & 1u;
+    }
+
+    // True if every bit set in `subset` is also set here.
+    bool containsAll(const CourseBitset& subset) const noexcept {
+        for (std::size_t i = 0; i < subset.m_words.size(); ++i) {
+            const std::uint64_t have = i < m_words.size() ? m_words[i] : 0;
+            if ((subset.m_words[i] & ~have) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void clear() noexcept { m_words.clear(); }
+    bool empty() const noexcept {
+        for (std::uint64_t w : m_words) {
+            if (w != 0) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr std::size_t kBitsPerWord = 64;
+    std::vector<std::uint64_t> m_words;
+};
@@ -1,26 +1,289 @@
 #include "CourseRegistry.h"
+#include <algorithm>
+#include <climits>
+#include "Epoch.h"
 
 bool CourseRegistry::addCourse(std::unique_ptr<Course> course) {
     if (!course) return false;
-    const auto id = course->id();
-    auto [it, inserted] = m_courses.emplace(id, std::move(course));
-    return inserted;
+    return emplaceCourse(std::move(*course)) != nullptr;
+}
+
+Course* CourseRegistry::insert(Pool::Handle handle, bool restoring) {
+    Course* course = m_pool.get(handle);
+    {
+        VersionCounter::Change change(m_version);
+        const PrerequisiteGraph::Result result =
+            restoring ? m_prerequisites.restoreCourse(course->id(), course->prerequisites())
+                      : m_prerequisites.addCourse(course->id(), course->prerequisites());
+        if (result != PrerequisiteGraph::Result::Ok) {
+            m_pool.destroy(handle);
+            return nullptr;
+        }
+        m_index.insert(course->id(), handle);   // cannot fail: the graph rejects duplicate ids
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        indexCourse(*course, handle);
+    }
+    if (m_log) {
+        m_log->courseAdded(*course);
+    }
+    return course;
+}
+
+std::vector<PrerequisiteGraph::Result> CourseRegistry::addCourses(std::vector<Course>& courses) {
+    SES_TIME_OPERATION(CourseAddBatch);
+    std::vector<PrerequisiteGraph::Result> results;
+    results.reserve(courses.size());
+    std::vector<const Course*> added;
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        for (Course& candidate : courses) {
+            // The graph goes first so a rejected course is never moved from.
+            results.push_back(m_prerequisites.addCourse(candidate.id(), candidate.prerequisites()));
+            if (results.back() != PrerequisiteGraph::Result::Ok) {
+                continue;
+            }
+            const Pool::Handle handle = m_pool.create(std::move(candidate));
+            const Course* course = m_pool.get(handle);
+            m_index.insert(course->id(), handle);
+            indexCourse(*course, handle);
+            added.push_back(course);
+        }
+    }
+    if (m_log) {
+        for (const Course* course : added) {
+            m_log->courseAdded(*course);
+        }
+    }
+    return results;
 }
 
 bool CourseRegistry::removeCourse(std::int32_t id) {
-    return m_courses.erase(id) > 0;
+    SES_TIME_OPERATION(CourseRemove);
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return false;
+    }
+    {
+        VersionCounter::Change change(m_version);
+        m_index.erase(id);
+        m_prerequisites.removeCourse(id);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        unindexCourse(*m_pool.get(handle), handle);
+    }
+    m_retired.emplace_back(Epoch::retire(), handle);
+    reclaimRemoved();
+    if (m_log) {
+        m_log->courseRemoved(id);
+    }
+    return true;
+}
+
+PrerequisiteGraph::Result CourseRegistry::setPrerequisites(std::int32_t id, std::vector<std::int32_t> prerequisites) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return PrerequisiteGraph::Result::CourseNotFound;
+    }
+    Course* course = m_pool.get(handle);
+    {
+        VersionCounter::Change change(m_version);
+        const PrerequisiteGraph::Result result = m_prerequisites.setPrerequisites(id, prerequisites);
+        if (result != PrerequisiteGraph::Result::Ok) {
+            return result;
+        }
+        course->setPrerequisites(std::move(prerequisites));
+    }
+    if (m_log) {
+        m_log->coursePrerequisitesChanged(*course);
+    }
+    return PrerequisiteGraph::Result::Ok;
+}
+
+bool CourseRegistry::setName(std::int32_t id, std::string name) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return false;
+    }
+    Course* course = m_pool.get(handle);
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        m_byName.erase(course->name(), handle);
+        course->setName(std::move(name));
+        m_byName.insert(course->name(), handle);
+    }
+    if (m_log) {
+        m_log->courseUpdated(*course);
+    }
+    return true;
+}
+
+bool CourseRegistry::setCredits(std::int32_t id, std::uint8_t credits) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return false;
+    }
+    Course* course = m_pool.get(handle);
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        m_byCredits.erase({course->credits(), id, handle});
+        --m_creditCounts[course->credits()];
+        course->setCredits(credits);
+        m_byCredits.insert({credits, id, handle});
+        ++m_creditCounts[credits];
+    }
+    if (m_log) {
+        m_log->courseUpdated(*course);
+    }
+    return true;
+}
+
+bool CourseRegistry::setInstructor(std::int32_t id, std::string_view instructor) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return false;
+    }
+    Course* course = m_pool.get(handle);
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        m_byInstructor.erase({course->instructorKey(), id, handle});
+        course->setInstructor(instructor);
+        m_byInstructor.insert({course->instructorKey(), id, handle});
+    }
+    if (m_log) {
+        m_log->courseUpdated(*course);
+    }
+    return true;
+}
+
+void CourseRegistry::indexCourse(const Course& course, Pool::Handle handle) {
+    m_byId.insert({course.id(), handle});
+    m_byInstructor.insert({course.instructorKey(), course.id(), handle});
+    m_byCredits.insert({course.credits(), course.id(), handle});
+    ++m_creditCounts[course.credits()];
+    m_byName.insert(course.name(), handle);
+}
+
+void CourseRegistry::unindexCourse(const Course& course, Pool::Handle handle) {
+    m_byId.erase({course.id(), handle});
+    m_byInstructor.erase({course.instructorKey(), course.id(), handle});
+    m_byCredits.erase({course.credits(), course.id(), handle});
+    --m_creditCounts[course.credits()];
+    m_byName.erase(course.name(), handle);
+}
+
+void CourseRegistry::reclaimRemoved() {
+    auto it = m_retired.begin();
+    while (it != m_retired.end() && Epoch::isReclaimable(it->first)) {
+        m_pool.destroy(it->second);
+        ++it;
+    }
+    m_retired.erase(m_retired.begin(), it);
 }
 
 Course* CourseRegistry::findCourse(std::int32_t id) const {
-    auto it = m_courses.find(id);
-    return it == m_courses.end() ? nullptr : it->second.get();
+    SES_TIME_OPERATION(CourseFind);
+    Epoch::Guard guard;
+    Pool::Handle handle;
+    return m_index.find(id, handle) ? m_pool.get(handle) : nullptr;
 }
 
-std::vector<const Course*> CourseRegistry::allCourses() const {
+CourseRegistry::CourseView CourseRegistry::firstPage(std::size_t limit) const {
+    SES_TIME_OPERATION(CourseList);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto first = m_byId.begin();
+    return CourseView(std::move(lock), first, advanceAtMost(first, m_byId.end(), limit), m_pool);
+}
+
+CourseRegistry::CourseView CourseRegistry::page(std::int32_t afterId, std::size_t limit) const {
+    SES_TIME_OPERATION(CourseList);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto first = m_byId.upper_bound({afterId, 0});
+    return CourseView(std::move(lock), first, advanceAtMost(first, m_byId.end(), limit), m_pool);
+}
+
+CourseRegistry::InstructorView CourseRegistry::coursesByInstructor(std::string_view instructor) const {
+    StringPool::Id key;
+    if (!StringPool::instructors().find(PrefixIndex::normalizeKey(instructor), key)) {
+        // Never interned, so no course has it
+        std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+        return InstructorView(std::move(lock), m_byInstructor.end(), m_byInstructor.end(), m_pool);
+    }
+    return coursesByInstructor(key);
+}
+
+CourseRegistry::InstructorView CourseRegistry::coursesByInstructor(StringPool::Id instructorKey) const {
+    SES_TIME_OPERATION(CourseFilter);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto first = m_byInstructor.lower_bound({instructorKey, INT32_MIN, 0});
+    const auto last = m_byInstructor.upper_bound({instructorKey, INT32_MAX, 0});
+    return InstructorView(std::move(lock), first, last, m_pool);
+}
+
+CourseRegistry::CreditsView CourseRegistry::coursesByCredits(std::uint8_t minCredits, std::uint8_t maxCredits) const {
+    SES_TIME_OPERATION(CourseFilter);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    if (minCredits > maxCredits) {
+        return CreditsView(std::move(lock), m_byCredits.end(), m_byCredits.end(), m_pool);
+    }
+    const auto first = m_byCredits.lower_bound({minCredits, INT32_MIN, 0});
+    const auto last = m_byCredits.upper_bound({maxCredits, INT32_MAX, 0});
+    return CreditsView(std::move(lock), first, last, m_pool);
+}
+
+std::size_t CourseRegistry::countByCredits(std::uint8_t minCredits, std::uint8_t maxCredits) const {
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    std::size_t count = 0;
+    for (unsigned credits = minCredits; credits <= maxCredits; ++credits) {
+        count += m_creditCounts[credits];
+    }
+    return count;
+}
+
+std::vector<const Course*> CourseRegistry::searchCoursesByName(std::string_view query, std::size_t limit) const {
+    SES_TIME_OPERATION(CourseSearch);
     std::vector<const Course*> result;
-    result.reserve(m_courses.size());
-    for (const auto& [id, ptr] : m_courses) {
-        result.push_back(ptr.get());
+    {
+        std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+        // The index returns matches in its own order, so the name order
+        // is only known once every match is in hand.
+        const std::vector<std::uint32_t> handles = m_byName.search(
+            query, SIZE_MAX, [this](std::uint32_t handle) -> const std::string& { return m_pool.get(handle)->name(); });
+        result.reserve(handles.size());
+        for (std::uint32_t handle : handles) {
+            result.push_back(m_pool.get(handle));
+        }
     }
+    const std::size_t kept = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(kept), result.end(),
+                      [](const Course* a, const Course* b) {
+                          return a->name() != b->name() ? a->name() < b->name() : a->id() < b->id();
+                      });
+    result.resize(kept);
     return result;
-} 
\ No newline at end of file
+}
+
+std::vector<const Course*> CourseRegistry::allCourses() const {
+    SES_TIME_OPERATION(CourseList);
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    std::vector<const Course*> result;
+    result.reserve(m_index.size());
+    const bool pendingRemovals = !m_retired.empty();
+    m_pool.forEach([&](const Course& course) {
+        // Removed entries stay in the pool until reclaimed; skip them.
+        Pool::Handle handle;
+        if (pendingRemovals && !(m_index.find(course.id(), handle) && m_pool.get(handle) == &course)) {
+            return;
+        }
+        result.push_back(&course);
+    });
+    return result;
+}
@@ -1,18 +1,159 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
+#include "ConcurrentIdMap.h"
+#include "IndexView.h"
+#include "ObjectPool.h"
+#include "PrefixIndex.h"
 #include "Course.h"
+#include "Metrics.h"
+#include "MutationLog.h"
+#include "PrerequisiteGraph.h"
+#include "VersionCounter.h"
 
+// Owns Course objects in a slab-backed ObjectPool. Lookups are lock-free
+// under an Epoch::Guard and removal is deferred; see StudentRegistry.
+//
+// Prerequisites are kept in a PrerequisiteGraph: a course is only added if
+// every prerequisite is a registered course and no cycle results, and
+// prerequisite lists of registered courses should be changed through
+// setPrerequisites() so the graph follows.
+//
+// Courses are also indexed by instructor, by credits and by name words.
+// Filtered and paged listings come back as IndexViews over the index itself rather
+// than as vectors; name, credits and instructor changes go through the
+// registry's setters to keep the indexes current.
 class CourseRegistry {
+    using Pool = ObjectPool<Course>;
+
+    template <typename Key>
+    struct IndexEntry {
+        Key key;
+        std::int32_t id;
+        Pool::Handle handle;
+
+        bool operator<(const IndexEntry& other) const {
+            return key < other.key || (!(other.key < key) && id < other.id);
+        }
+    };
+    using IdIndex = std::set<IdIndexEntry>;
+    using InstructorIndex = std::set<IndexEntry<StringPool::Id>>;   // (Course::instructorKey(), id)
+    using CreditsIndex = std::set<IndexEntry<std::uint8_t>>;         // (credits, id)
+
 public:
+    // Filtered or paged courses; see IndexView for the locking rules.
+    using CourseView = IndexView<IdIndex::const_iterator, Course>;
+    using InstructorView = IndexView<InstructorIndex::const_iterator, Course>;
+    using CreditsView = IndexView<CreditsIndex::const_iterator, Course>;
+
     bool addCourse(std::unique_ptr<Course> course);
+
+    // Constructs a course in place. Returns nullptr if the id is taken or
+    // the prerequisites are rejected (see checkPrerequisites).
+    template <typename... Args>
+    Course* emplaceCourse(Args&&... args) {
+        SES_TIME_OPERATION(CourseAdd);
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return insert(m_pool.create(std::forward<Args>(args)...), false);
+    }
+    // Adds `courses` in order, as emplaceCourse would one at a time, but
+    // takes the registry's locks once for the whole batch; for bulk loads.
+    // A course may list one earlier in the batch as a prerequisite. Added
+    // courses are moved out of the vector, rejected ones are left as they
+    // were. Returns one result per course: Ok, DuplicateCourse,
+    // UnknownPrerequisite or Cycle.
+    std::vector<PrerequisiteGraph::Result> addCourses(std::vector<Course>& courses);
+    // emplaceCourse for loading saved catalogs in any order: prerequisites
+    // that are not registered (yet) are kept as placeholders. Cycles are
+    // still rejected.
+    template <typename... Args>
+    Course* restoreCourse(Args&&... args) {
+        SES_TIME_OPERATION(CourseAdd);
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return insert(m_pool.create(std::forward<Args>(args)...), true);
+    }
     bool removeCourse(std::int32_t id);
 
+    // Replaces a course's prerequisite list if the graph accepts it. Like
+    // the Course setters, must not run while other threads enroll.
+    PrerequisiteGraph::Result setPrerequisites(std::int32_t id, std::vector<std::int32_t> prerequisites);
+    // Why addCourse/setPrerequisites would reject `prerequisites` for `id`.
+    PrerequisiteGraph::Result checkPrerequisites(std::int32_t id, const std::vector<std::int32_t>& prerequisites) const {
+        return m_prerequisites.check(id, prerequisites);
+    }
+    const PrerequisiteGraph& prerequisiteGraph() const noexcept { return m_prerequisites; }
+
     Course* findCourse(std::int32_t id) const;
     std::vector<const Course*> allCourses() const;
+    // Pages through courses in id order, as StudentRegistry::page does.
+    CourseView firstPage(std::size_t limit) const;
+    CourseView page(std::int32_t afterId, std::size_t limit) const;
+
+    // Courses taught by `instructor` (ignoring case and surrounding
+    // whitespace), by id.
+    InstructorView coursesByInstructor(std::string_view instructor) const;
+    // Same, for an instructorKey() of some course.
+    InstructorView coursesByInstructor(StringPool::Id instructorKey) const;
+    // Courses worth minCredits..maxCredits inclusive, by credits, then id.
+    CreditsView coursesByCredits(std::uint8_t minCredits, std::uint8_t maxCredits) const;
+    // Number of courses worth minCredits..maxCredits, from a histogram.
+    std::size_t countByCredits(std::uint8_t minCredits, std::uint8_t maxCredits) const;
+    // Courses with a name word starting with each word of `query`
+    // (case-insensitive), sorted by name, at most `limit` of them.
+    std::vector<const Course*> searchCoursesByName(std::string_view query, std::size_t limit = SIZE_MAX) const;
+
+    // Change a registered course and re-index it. Like setPrerequisites,
+    // must not run while other threads enroll. Return false if no course
+    // has the id.
+    bool setName(std::int32_t id, std::string name);
+    bool setCredits(std::int32_t id, std::uint8_t credits);
+    bool setInstructor(std::int32_t id, std::string_view instructor);
+
+    std::size_t size() const noexcept { return m_index.size(); }
+    // Number of changes made (a rejected add or prerequisite change may
+    // count too), or VersionCounter::kChanging while one is under way; two
+    // equal readings mean nothing changed in between (e.g. to keep a cached
+    // view). See VersionCounter.
+    std::uint64_t version() const noexcept { return m_version.read(); }
+    void reserve(std::size_t count) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_index.reserve(count);
+        m_pool.reserve(count);
+    }
+
+    // Reports successful adds/removes to `log` (not owned; nullptr to detach).
+    void setMutationLog(MutationLog* log) noexcept { m_log = log; }
 
 private:
-    std::unordered_map<std::int32_t, std::unique_ptr<Course>> m_courses;
+    Course* insert(Pool::Handle handle, bool restoring);
+    void reclaimRemoved();
+    // Index updates; the caller holds m_writeMutex and m_searchMutex.
+    void indexCourse(const Course& course, Pool::Handle handle);
+    void unindexCourse(const Course& course, Pool::Handle handle);
+
+    Pool m_pool;
+    ConcurrentIdMap m_index;                               // id -> handle
+    std::vector<std::pair<std::uint64_t, Pool::Handle>> m_retired;   // (epoch stamp, removed handle)
+    PrerequisiteGraph m_prerequisites;                     // courses in m_index, plus placeholders
+    mutable std::mutex m_writeMutex;                       // serializes pool, index and graph writers
+
+    // Secondary indexes; written under m_writeMutex and m_searchMutex.
+    IdIndex m_byId;                                        // id order, for paging
+    InstructorIndex m_byInstructor;
+    CreditsIndex m_byCredits;
+    std::array<std::size_t, 256> m_creditCounts{};          // courses per credit value
+    PrefixIndex m_byName;                                  // name words -> handle
+    mutable std::shared_mutex m_searchMutex;
+    VersionCounter m_version;
+    MutationLog* m_log = nullptr;
 }; 
\ No newline at end of file
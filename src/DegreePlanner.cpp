@@ -0,0 +1,225 @@
+#include "DegreePlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Epoch.h"
+
+DegreePlanner::DegreePlanner(const CourseRegistry& courses, const EnrollmentManager& enrollments)
+    : m_enrollments(enrollments) {
+    Epoch::Guard guard;
+    const std::vector<const Course*> catalog = courses.allCourses();
+    m_nodes.reserve(catalog.size());
+    for (const Course* course : catalog) {
+        Node& node = m_nodes[nodeFor(course->id())];
+        node.credits = course->credits();
+        node.live = true;
+    }
+    for (const Course* course : catalog) {
+        const std::uint32_t index = m_ids.at(course->id());
+        for (std::int32_t prereqId : course->prerequisites()) {
+            const std::uint32_t prereq = nodeFor(prereqId);
+            auto& prerequisites = m_nodes[index].prerequisites;
+            if (std::find(prerequisites.begin(), prerequisites.end(), prereq) == prerequisites.end()) {
+                prerequisites.push_back(prereq);
+            }
+        }
+    }
+}
+
+std::uint32_t DegreePlanner::nodeFor(std::int32_t courseId) {
+    const auto [it, inserted] = m_ids.try_emplace(courseId, static_cast<std::uint32_t>(m_nodes.size()));
+    if (inserted) {
+        m_nodes.emplace_back();
+        m_nodes.back().id = courseId;
+    }
+    return it->second;
+}
+
+DegreePlanner::Plan DegreePlanner::plan(std::int32_t studentId, const std::vector<std::int32_t>& targets,
+                                        const Options& options) const {
+    Scratch scratch;
+    return planWith(scratch, studentId, targets, options);
+}
+
+std::vector<DegreePlanner::Plan> DegreePlanner::planBatch(const std::vector<std::int32_t>& studentIds,
+                                                          const std::vector<std::int32_t>& targets,
+                                                          const Options& options, unsigned threads) const {
+    constexpr std::size_t kChunk = 64;
+    std::vector<Plan> plans(studentIds.size());
+    std::atomic<std::size_t> nextChunk{0};
+    auto worker = [&] {
+        Scratch scratch;
+        for (;;) {
+            const std::size_t begin = nextChunk.fetch_add(kChunk, std::memory_order_relaxed);
+            if (begin >= studentIds.size()) {
+                return;
+            }
+            const std::size_t end = std::min(begin + kChunk, studentIds.size());
+            for (std::size_t i = begin; i < end; ++i) {
+                plans[i] = planWith(scratch, studentIds[i], targets, options);
+            }
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, (studentIds.size() + kChunk - 1) / kChunk));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return plans;
+}
+
+DegreePlanner::Plan DegreePlanner::planWith(Scratch& scratch, std::int32_t studentId,
+                                            const std::vector<std::int32_t>& targets, const Options& options) const {
+    Plan plan;
+    plan.studentId = studentId;
+
+    if (scratch.completed.size() != m_nodes.size()) {
+        scratch.completed.assign(m_nodes.size(), 0);
+        scratch.visited.assign(m_nodes.size(), 0);
+        scratch.slot.assign(m_nodes.size(), 0);
+        scratch.stamp = 0;
+    }
+    if (++scratch.stamp == 0) {
+        std::fill(scratch.completed.begin(), scratch.completed.end(), 0);
+        std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+        scratch.stamp = 1;
+    }
+    const std::uint32_t stamp = scratch.stamp;
+
+    for (std::int32_t courseId : m_enrollments.getCompletedCourses(studentId, options.countInProgress)) {
+        const auto it = m_ids.find(courseId);
+        if (it != m_ids.end()) {
+            scratch.completed[it->second] = stamp;
+        }
+    }
+
+    // Collect the needed courses in post-order, so every course comes after
+    // its needed prerequisites. A node is marked when it is expanded; stale
+    // duplicate stack entries are skipped.
+    std::vector<std::uint32_t>& needed = scratch.needed;
+    needed.clear();
+    for (std::int32_t targetId : targets) {
+        const auto it = m_ids.find(targetId);
+        if (it == m_ids.end()) {
+            plan.blocked.push_back(targetId);
+            continue;
+        }
+        auto& stack = scratch.stack;
+        stack.assign(1, {it->second, false});
+        while (!stack.empty()) {
+            const auto [index, expanded] = stack.back();
+            if (expanded) {
+                stack.pop_back();
+                scratch.slot[index] = static_cast<std::uint32_t>(needed.size());
+                needed.push_back(index);
+                continue;
+            }
+            if (scratch.completed[index] == stamp || scratch.visited[index] == stamp) {
+                stack.pop_back();
+                continue;
+            }
+            scratch.visited[index] = stamp;
+            stack.back().second = true;
+            for (std::uint32_t prereq : m_nodes[index].prerequisites) {
+                if (scratch.completed[prereq] != stamp && scratch.visited[prereq] != stamp) {
+                    stack.emplace_back(prereq, false);
+                }
+            }
+        }
+    }
+
+    const std::size_t count = needed.size();
+    scratch.height.assign(count, 1);
+    scratch.blocked.assign(count, 0);
+    scratch.waitingOn.assign(count, 0);
+    if (scratch.dependents.size() < count) {
+        scratch.dependents.resize(count);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        scratch.dependents[i].clear();
+    }
+
+    // Prerequisites first: wire up needed edges and propagate blocking.
+    for (std::size_t i = 0; i < count; ++i) {
+        const Node& node = m_nodes[needed[i]];
+        bool blocked = !node.live || node.credits > options.creditCap;
+        for (std::uint32_t prereq : node.prerequisites) {
+            if (scratch.completed[prereq] == stamp) continue;
+            const std::uint32_t p = scratch.slot[prereq];
+            blocked = blocked || scratch.blocked[p];
+            ++scratch.waitingOn[i];
+            scratch.dependents[p].push_back(static_cast<std::uint32_t>(i));
+        }
+        scratch.blocked[i] = blocked;
+        if (blocked) {
+            plan.blocked.push_back(node.id);
+        }
+    }
+
+    // Dependents first: height is the longest chain from here to a target.
+    std::size_t totalCredits = 0;
+    std::uint32_t longestChain = 0;
+    for (std::size_t i = count; i-- > 0;) {
+        if (scratch.blocked[i]) continue;
+        const Node& node = m_nodes[needed[i]];
+        totalCredits += node.credits;
+        longestChain = std::max(longestChain, scratch.height[i]);
+        for (std::uint32_t prereq : node.prerequisites) {
+            if (scratch.completed[prereq] == stamp) continue;
+            std::uint32_t& height = scratch.height[scratch.slot[prereq]];
+            height = std::max(height, scratch.height[i] + 1);
+        }
+    }
+    plan.lowerBound = longestChain;
+    if (options.creditCap > 0) {
+        plan.lowerBound = std::max(plan.lowerBound, (totalCredits + options.creditCap - 1) / options.creditCap);
+    }
+
+    std::vector<std::uint32_t>& ready = scratch.ready;
+    std::vector<std::uint32_t>& next = scratch.next;
+    ready.clear();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!scratch.blocked[i] && scratch.waitingOn[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    auto before = [&](std::uint32_t a, std::uint32_t b) {
+        if (scratch.height[a] != scratch.height[b]) return scratch.height[a] > scratch.height[b];
+        const Node& x = m_nodes[needed[a]];
+        const Node& y = m_nodes[needed[b]];
+        return x.credits != y.credits ? x.credits > y.credits : x.id < y.id;
+    };
+    while (!ready.empty()) {
+        std::sort(ready.begin(), ready.end(), before);
+        Semester semester;
+        next.clear();
+        for (std::uint32_t i : ready) {
+            const Node& node = m_nodes[needed[i]];
+            if (semester.credits + node.credits > options.creditCap) {
+                next.push_back(i);
+                continue;
+            }
+            semester.courses.push_back(node.id);
+            semester.credits += node.credits;
+            for (std::uint32_t dependent : scratch.dependents[i]) {
+                if (--scratch.waitingOn[dependent] == 0 && !scratch.blocked[dependent]) {
+                    next.push_back(dependent);
+                }
+            }
+        }
+        if (semester.courses.empty()) {
+            break;   // unreachable: blocked courses are the only ones over the cap
+        }
+        plan.semesters.push_back(std::move(semester));
+        std::swap(ready, next);
+    }
+    return plan;
+}
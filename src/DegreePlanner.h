@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+
+// Semester-by-semester plans from a student's transcript to a set of target
+// courses under a per-semester credit cap.
+//
+// The courses still needed are the targets plus every prerequisite below
+// them that the student has not completed (completed courses cut the walk:
+// their own prerequisites are taken as satisfied). These are scheduled in
+// layers: a course becomes available the semester after its last needed
+// prerequisite, and each semester is packed first-fit from the available
+// courses, longest remaining chain first, then largest credits. This is
+// list scheduling, so a plan is not always the shortest possible;
+// Plan::lowerBound says how far off it can be.
+//
+// The planner copies ids, credits and prerequisite lists out of the
+// CourseRegistry when constructed, so planning never touches the registry;
+// build a new planner after changing the catalog. Completed courses are
+// read from EnrollmentManager at plan time. plan() is const and safe to call
+// from many threads; planBatch() does exactly that.
+class DegreePlanner {
+public:
+    struct Options {
+        unsigned creditCap = 18;
+        bool countInProgress = true;   // treat active enrollments as completed
+    };
+
+    struct Semester {
+        std::vector<std::int32_t> courses;
+        unsigned credits = 0;
+    };
+
+    struct Plan {
+        std::int32_t studentId = 0;
+        std::vector<Semester> semesters;
+        // Needed courses that cannot be scheduled: unknown or removed
+        // courses, courses over the credit cap, and everything above them.
+        std::vector<std::int32_t> blocked;
+        // No plan for the schedulable courses can take fewer semesters:
+        // the longest chain, or total credits over the cap, if larger.
+        std::size_t lowerBound = 0;
+
+        bool complete() const noexcept { return blocked.empty(); }
+    };
+
+    DegreePlanner(const CourseRegistry& courses, const EnrollmentManager& enrollments);
+
+    Plan plan(std::int32_t studentId, const std::vector<std::int32_t>& targets, const Options& options) const;
+    // One plan per student, in order, computed on `threads` threads
+    // (0 = one per hardware thread).
+    std::vector<Plan> planBatch(const std::vector<std::int32_t>& studentIds, const std::vector<std::int32_t>& targets,
+                                const Options& options, unsigned threads = 0) const;
+
+private:
+    struct Node {
+        std::int32_t id = 0;
+        std::uint8_t credits = 0;
+        bool live = false;                          // false for prerequisites that are not in the catalog
+        std::vector<std::uint32_t> prerequisites;   // node indices
+    };
+
+    // Per-thread working memory, sized to the catalog once and reset by
+    // bumping `stamp` rather than clearing.
+    struct Scratch {
+        std::uint32_t stamp = 0;
+        std::vector<std::uint32_t> completed;       // == stamp: completed
+        std::vector<std::uint32_t> visited;         // == stamp: already walked
+        std::vector<std::uint32_t> slot;            // position in `needed`, valid when visited
+        std::vector<std::uint32_t> needed;          // node indices, prerequisites first
+        std::vector<std::uint32_t> height;          // per `needed` entry: longest chain up to a target
+        std::vector<std::uint8_t> blocked;          // per `needed` entry
+        std::vector<std::uint32_t> waitingOn;       // unscheduled needed prerequisites, per `needed` entry
+        std::vector<std::vector<std::uint32_t>> dependents;   // per `needed` entry, `needed` positions
+        std::vector<std::pair<std::uint32_t, bool>> stack;
+        std::vector<std::uint32_t> ready;
+        std::vector<std::uint32_t> next;
+    };
+
+    Plan planWith(Scratch& scratch, std::int32_t studentId, const std::vector<std::int32_t>& targets,
+                  const Options& options) const;
+    std::uint32_t nodeFor(std::int32_t courseId);
+
+    const EnrollmentManager& m_enrollments;
+    std::vector<Node> m_nodes;
+    std::unordered_map<std::int32_t, std::uint32_t> m_ids;   // course id -> node index
+};
@@ -6,4 +6,13 @@ Enrollment::Enrollment(std::int32_t studentId,
     : m_studentId(studentId),
       m_courseId(courseId),
       m_status(status),
-      m_enrollmentDate(std::chrono::system_clock::now()) {} 
\ No newline at end of file
+      m_enrollmentDate(std::chrono::system_clock::now()) {}
+
+Enrollment::Enrollment(std::int32_t studentId,
+                       std::int32_t courseId,
+                       Status status,
+                       std::chrono::system_clock::time_point enrollmentDate)
+    : m_studentId(studentId),
+      m_courseId(courseId),
+      m_status(status),
+      m_enrollmentDate(enrollmentDate) {} 
\ No newline at end of file
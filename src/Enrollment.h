@@ -17,6 +17,12 @@ public:
                std::int32_t courseId,
                Status status = Status::Active);
 
+    // Restores a previously recorded enrollment with its original date
+    Enrollment(std::int32_t studentId,
+               std::int32_t courseId,
+               Status status,
+               std::chrono::system_clock::time_point enrollmentDate);
+
     // Immutable getters
     std::int32_t studentId() const noexcept { return m_studentId; }
     std::int32_t courseId() const noexcept { return m_courseId; }
@@ -1,129 +1,562 @@
 #include "EnrollmentManager.h"
 #include <algorithm>
+#include <chrono>
+#include <optional>
+#include <type_traits>
+#include "Epoch.h"
 
 EnrollmentManager::EnrollmentManager(const StudentRegistry& students, const CourseRegistry& courses)
     : m_students(students), m_courses(courses) {}
 
+static_assert(static_cast<int>(Metrics::Counter::EnrollCourseFull) ==
+                  static_cast<int>(EnrollmentManager::EnrollmentResult::CourseFull),
+              "Metrics::Counter must list EnrollmentResult outcomes in order");
+
 EnrollmentManager::EnrollmentResult EnrollmentManager::enrollStudent(std::int32_t studentId, std::int32_t courseId) {
+    SES_TIME_OPERATION(Enroll);
+    const EnrollmentResult result = enrollChecked(studentId, courseId);
+    SES_COUNT(static_cast<Metrics::Counter>(result));
+    return result;
+}
+
+EnrollmentManager::EnrollmentResult EnrollmentManager::enrollChecked(std::int32_t studentId, std::int32_t courseId) {
+    Epoch::Guard guard;
+
     // Validate student exists
     if (!m_students.findStudent(studentId)) {
         return EnrollmentResult::StudentNotFound;
     }
-    
+
     // Validate course exists
     const Course* course = m_courses.findCourse(courseId);
     if (!course) {
         return EnrollmentResult::CourseNotFound;
     }
-    
+
+    CourseState& state = courseState(courseId);
+    std::lock_guard<std::mutex> lock(state.mutex);
+
     // Check if already enrolled
-    if (isAlreadyEnrolled(studentId, courseId)) {
+    if (state.activeRows.count(studentId) != 0) {
         return EnrollmentResult::AlreadyEnrolled;
     }
-    
+
     // Check prerequisites
-    if (!hasPrerequisites(studentId, courseId)) {
+    if (!meetsPrerequisitesLocked(*course, state, studentId)) {
         return EnrollmentResult::PrerequisitesNotMet;
     }
-    
+
+    // Check capacity; a full course queues the student instead
+    if (!hasFreeSeat(*course, state)) {
+        if (m_waitlists) {
+            m_waitlists->addToWaitlist(courseId, studentId);
+        }
+        return EnrollmentResult::CourseFull;
+    }
+
     // Create enrollment
-    m_enrollments.push_back(std::make_unique<Enrollment>(studentId, courseId));
+    appendRowLocked(state, Enrollment(studentId, courseId), course->credits());
+    if (m_waitlists && m_waitlists->isOnWaitlist(courseId, studentId)) {
+        m_waitlists->removeFromWaitlist(courseId, studentId);
+    }
     return EnrollmentResult::Success;
 }
 
+bool EnrollmentManager::restoreEnrollment(const Enrollment& enrollment) {
+    SES_TIME_OPERATION(Restore);
+    Epoch::Guard guard;
+    CourseState& state = courseState(enrollment.courseId());
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (enrollment.isActive() && state.activeRows.count(enrollment.studentId()) != 0) {
+        return false;
+    }
+    const Course* course = m_courses.findCourse(enrollment.courseId());
+    appendRowLocked(state, enrollment, course ? course->credits() : 0);
+    return true;
+}
+
+void EnrollmentManager::reserve(std::size_t count) {
+    m_enrollments.reserve(count);
+}
+
 bool EnrollmentManager::dropStudent(std::int32_t studentId, std::int32_t courseId) {
-    auto it = std::find_if(m_enrollments.begin(), m_enrollments.end(),
-        [studentId, courseId](const std::unique_ptr<Enrollment>& enrollment) {
-            return enrollment->studentId() == studentId && 
-                   enrollment->courseId() == courseId && 
-                   enrollment->isActive();
-        });
-    
-    if (it != m_enrollments.end()) {
-        (*it)->setStatus(Enrollment::Status::Dropped);
-        return true;
+    SES_TIME_OPERATION(Drop);
+    Epoch::Guard guard;
+    CourseState& state = courseState(courseId);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!setStatusLocked(state, studentId, courseId, Enrollment::Status::Dropped)) {
+        return false;
+    }
+    if (const Course* course = m_courses.findCourse(courseId)) {
+        promoteLocked(*course, state);
+    }
+    return true;
+}
+
+std::vector<EnrollmentManager::EnrollmentResult> EnrollmentManager::enrollBatch(const std::vector<EnrollRequest>& requests) {
+    SES_TIME_OPERATION(EnrollBatch);
+    // Requests for different courses never affect each other's outcome, so
+    // processing course by course, in request order within each course,
+    // gives the same results as processing them in the original order.
+    std::vector<EnrollmentResult> results(requests.size());
+
+    // Group request indices by course with a counting sort: number the
+    // distinct courses, count each group, then scatter.
+    std::unordered_map<std::int32_t, std::uint32_t> groupOf;
+    std::vector<std::uint32_t> groupStart;
+    std::vector<std::uint32_t> groupIds(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        auto [it, inserted] = groupOf.try_emplace(requests[i].second, static_cast<std::uint32_t>(groupStart.size()));
+        if (inserted) {
+            groupStart.push_back(0);
+        }
+        groupIds[i] = it->second;
+        ++groupStart[it->second];
+    }
+    std::uint32_t offset = 0;
+    for (std::uint32_t& start : groupStart) {
+        const std::uint32_t count = start;
+        start = offset;
+        offset += count;
+    }
+    groupStart.push_back(offset);
+    std::vector<std::uint32_t> order(requests.size());
+    {
+        std::vector<std::uint32_t> next(groupStart.begin(), groupStart.end() - 1);
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            order[next[groupIds[i]]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    Epoch::Guard guard;
+
+    // Completed sets are read once per student, and only for courses that
+    // have prerequisites.
+    std::unordered_map<std::int32_t, CourseBitset> completedSets;
+    auto completedFor = [&](std::int32_t studentId) -> const CourseBitset& {
+        auto [it, inserted] = completedSets.try_emplace(studentId);
+        if (inserted) {
+            if (StudentState* student = findState(studentId, m_studentIndex, m_studentStates)) {
+                std::lock_guard<std::mutex> lock(student->mutex);
+                it->second = student->completed;
+            }
+        }
+        return it->second;
+    };
+
+    constexpr std::size_t kPendingRow = SIZE_MAX;
+    // One timestamp for the whole batch; it is enrolled as one unit.
+    const auto enrolledAt = std::chrono::system_clock::now();
+    std::vector<Enrollment> accepted;
+    std::vector<std::int32_t> dequeued;   // accepted students to take off the waitlist
+    for (std::size_t group = 0; group + 1 < groupStart.size(); ++group) {
+        const std::size_t begin = groupStart[group];
+        const std::size_t end = groupStart[group + 1];
+        const std::int32_t courseId = requests[order[begin]].second;
+
+        const Course* course = m_courses.findCourse(courseId);
+        if (!course) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::int32_t studentId = requests[order[i]].first;
+                results[order[i]] = m_students.findStudent(studentId) ? EnrollmentResult::CourseNotFound
+                                                                      : EnrollmentResult::StudentNotFound;
+            }
+            continue;
+        }
+
+        CourseState& state = courseState(courseId);
+        std::lock_guard<std::mutex> lock(state.mutex);
+        const bool hasPrerequisites = !course->prerequisites().empty();
+        const CourseBitset* required = hasPrerequisites ? &prerequisiteMaskLocked(*course, state) : nullptr;
+        std::size_t taken = state.activeCount.load(std::memory_order_relaxed);
+        bool waitlisted = m_waitlists && !m_waitlists->isWaitlistEmpty(courseId);
+
+        accepted.clear();
+        dequeued.clear();
+        std::optional<VersionCounter::Change> change;   // opened by the first accepted request
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::int32_t studentId = requests[order[i]].first;
+            EnrollmentResult& result = results[order[i]];
+            if (!m_students.findStudent(studentId)) {
+                result = EnrollmentResult::StudentNotFound;
+            } else if (state.activeRows.count(studentId) != 0) {
+                result = EnrollmentResult::AlreadyEnrolled;
+            } else if (required && !completedFor(studentId).containsAll(*required)) {
+                result = EnrollmentResult::PrerequisitesNotMet;
+            } else if (course->hasCapacityLimit() && taken >= course->capacity()) {
+                result = EnrollmentResult::CourseFull;
+                if (m_waitlists) {
+                    m_waitlists->addToWaitlist(courseId, studentId);
+                    waitlisted = true;
+                }
+            } else {
+                result = EnrollmentResult::Success;
+                if (!change) {
+                    change.emplace(m_version);
+                }
+                // Reserve the seat; the row index is filled in below.
+                state.activeRows.emplace(studentId, ActiveRow{kPendingRow, course->credits()});
+                ++taken;
+                accepted.emplace_back(studentId, courseId, Enrollment::Status::Active, enrolledAt);
+                if (waitlisted && m_waitlists->isOnWaitlist(courseId, studentId)) {
+                    dequeued.push_back(studentId);
+                }
+            }
+        }
+
+        if (!accepted.empty()) {
+            const std::size_t firstRow = m_enrollments.append(accepted.data(), accepted.size());
+            for (std::size_t k = 0; k < accepted.size(); ++k) {
+                indexRowLocked(state, accepted[k], firstRow + k, course->credits());
+            }
+        }
+        // After the rows, as in enrollStudent, so the log never drops a
+        // student from the waitlist before recording their enrollment.
+        for (std::int32_t studentId : dequeued) {
+            m_waitlists->removeFromWaitlist(courseId, studentId);
+        }
+    }
+    if constexpr (Metrics::enabled()) {
+        for (EnrollmentResult result : results) {
+            Metrics::increment(static_cast<Metrics::Counter>(result));
+        }
+    }
+    return results;
+}
+
+std::size_t EnrollmentManager::promoteFromWaitlist(std::int32_t courseId) {
+    SES_TIME_OPERATION(Promote);
+    Epoch::Guard guard;
+    const Course* course = m_courses.findCourse(courseId);
+    if (!course) {
+        return 0;
+    }
+    CourseState& state = courseState(courseId);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return promoteLocked(*course, state);
+}
+
+bool EnrollmentManager::setCapacity(std::int32_t courseId, std::uint16_t capacity) {
+    SES_TIME_OPERATION(SetCapacity);
+    Epoch::Guard guard;
+    Course* course = m_courses.findCourse(courseId);
+    if (!course) {
+        return false;
+    }
+    CourseState& state = courseState(courseId);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    {
+        VersionCounter::Change change(m_version);
+        course->setCapacity(capacity);
+    }
+    if (m_log) {
+        m_log->courseCapacityChanged(courseId, capacity);
+    }
+    promoteLocked(*course, state);
+    return true;
+}
+
+std::size_t EnrollmentManager::promoteLocked(const Course& course, CourseState& state) {
+    if (!m_waitlists) {
+        return 0;
+    }
+
+    std::size_t promoted = 0;
+    while (hasFreeSeat(course, state) && !m_waitlists->isWaitlistEmpty(course.id())) {
+        const std::int32_t studentId = m_waitlists->getNextFromWaitlist(course.id());
+        if (m_students.findStudent(studentId) &&
+            state.activeRows.count(studentId) == 0 &&
+            meetsPrerequisitesLocked(course, state, studentId)) {
+            appendRowLocked(state, Enrollment(studentId, course.id()), course.credits());
+            ++promoted;
+        }
+    }
+    return promoted;
+}
+
+std::size_t EnrollmentManager::activeEnrollmentCount(std::int32_t courseId) const {
+    SES_TIME_OPERATION(ActiveCount);
+    Epoch::Guard guard;
+    const CourseState* state = findState(courseId, m_courseIndex, m_courseStates);
+    return state ? state->activeCount.load(std::memory_order_relaxed) : 0;
+}
+
+std::size_t EnrollmentManager::seatsRemaining(std::int32_t courseId) const {
+    SES_TIME_OPERATION(SeatsRemaining);
+    Epoch::Guard guard;
+    const Course* course = m_courses.findCourse(courseId);
+    if (!course) {
+        return 0;
+    }
+    if (!course->hasCapacityLimit()) {
+        return kUnlimitedSeats;
+    }
+    const std::size_t taken = activeEnrollmentCount(courseId);
+    return taken >= course->capacity() ? 0 : course->capacity() - taken;
+}
+
+bool EnrollmentManager::setEnrollmentStatus(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status) {
+    SES_TIME_OPERATION(SetStatus);
+    Epoch::Guard guard;
+    CourseState* state = findState(courseId, m_courseIndex, m_courseStates);
+    if (!state) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return setStatusLocked(*state, studentId, courseId, status);
+}
+
+bool EnrollmentManager::setStatusLocked(CourseState& course, std::int32_t studentId, std::int32_t courseId,
+                                        Enrollment::Status status) {
+    if (status == Enrollment::Status::Active) {
+        return false;
+    }
+
+    auto it = course.activeRows.find(studentId);
+    if (it == course.activeRows.end()) {
+        return false;
+    }
+
+    {
+        VersionCounter::Change change(m_version);
+        m_enrollments.setStatus(it->second.row, status);
+        const std::uint8_t credits = it->second.credits;
+        course.activeRows.erase(it);
+        course.activeCount.fetch_sub(1, std::memory_order_relaxed);
+
+        if (status == Enrollment::Status::Completed) {
+            StudentState& student = studentState(studentId);
+            std::lock_guard<std::mutex> lock(student.mutex);
+            student.completed.set(course.slot);
+        }
+        if (m_aggregates) {
+            m_aggregates->enrollmentStatusChanged(studentId, courseId, Enrollment::Status::Active, status, credits);
+        }
     }
-    return false;
+    if (m_log) {
+        m_log->enrollmentStatusChanged(studentId, courseId, status);
+    }
+    return true;
+}
+
+std::vector<Enrollment> EnrollmentManager::getStudentEnrollments(std::int32_t studentId) const {
+    SES_TIME_OPERATION(StudentEnrollments);
+    Epoch::Guard guard;
+    StudentState* state = findState(studentId, m_studentIndex, m_studentStates);
+    if (!state) {
+        return {};
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    std::vector<std::size_t> rows = state->rows;
+    lock.unlock();
+    return activeRows(std::move(rows));
 }
 
-std::vector<const Enrollment*> EnrollmentManager::getStudentEnrollments(std::int32_t studentId) const {
-    std::vector<const Enrollment*> result;
-    for (const auto& enrollment : m_enrollments) {
-        if (enrollment->studentId() == studentId && enrollment->isActive()) {
-            result.push_back(enrollment.get());
+std::vector<Enrollment> EnrollmentManager::getCourseEnrollments(std::int32_t courseId) const {
+    SES_TIME_OPERATION(CourseEnrollments);
+    Epoch::Guard guard;
+    CourseState* state = findState(courseId, m_courseIndex, m_courseStates);
+    if (!state) {
+        return {};
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    std::vector<std::size_t> rows = state->rows;
+    lock.unlock();
+    return activeRows(std::move(rows));
+}
+
+std::vector<std::int32_t> EnrollmentManager::getCompletedCourses(std::int32_t studentId, bool includeActive) const {
+    SES_TIME_OPERATION(CompletedCourses);
+    StudentState* state = findState(studentId, m_studentIndex, m_studentStates);
+    if (!state) {
+        return {};
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    std::vector<std::size_t> rows = state->rows;
+    lock.unlock();
+
+    std::vector<std::int32_t> result;
+    for (std::size_t row : rows) {
+        const Enrollment::Status status = m_enrollments.status(row);
+        if (status == Enrollment::Status::Completed || (includeActive && status == Enrollment::Status::Active)) {
+            result.push_back(m_enrollments.courseId(row));
         }
     }
     return result;
 }
 
-std::vector<const Enrollment*> EnrollmentManager::getCourseEnrollments(std::int32_t courseId) const {
-    std::vector<const Enrollment*> result;
-    for (const auto& enrollment : m_enrollments) {
-        if (enrollment->courseId() == courseId && enrollment->isActive()) {
-            result.push_back(enrollment.get());
+std::vector<Enrollment> EnrollmentManager::activeRows(std::vector<std::size_t> rows) const {
+    std::vector<Enrollment> result;
+    for (std::size_t row : rows) {
+        if (m_enrollments.status(row) == Enrollment::Status::Active) {
+            result.push_back(m_enrollments.row(row));
         }
     }
     return result;
 }
 
-std::vector<const Enrollment*> EnrollmentManager::getAllEnrollments() const {
-    std::vector<const Enrollment*> result;
-    result.reserve(m_enrollments.size());
-    for (const auto& enrollment : m_enrollments) {
-        result.push_back(enrollment.get());
+std::vector<Enrollment> EnrollmentManager::getAllEnrollments() const {
+    SES_TIME_OPERATION(AllEnrollments);
+    const std::size_t size = m_enrollments.size();
+    std::vector<Enrollment> result;
+    result.reserve(size);
+    for (std::size_t row = 0; row < size; ++row) {
+        result.push_back(m_enrollments.row(row));
     }
     return result;
 }
 
+EnrollmentManager::EnrollmentView EnrollmentManager::enrollmentsPage(std::size_t fromRow, std::size_t limit) const {
+    SES_TIME_OPERATION(AllEnrollments);
+    const std::size_t size = m_enrollments.size();
+    const std::size_t first = std::min(fromRow, size);
+    const std::size_t last = first + std::min(limit, size - first);
+    return EnrollmentView(m_enrollments, first, last);
+}
+
+std::size_t EnrollmentManager::enrollmentCount() const {
+    return m_enrollments.size();
+}
+
+std::unordered_map<std::int32_t, std::size_t> EnrollmentManager::countByCourse(Enrollment::Status status) const {
+    SES_TIME_OPERATION(CountByCourse);
+    return m_enrollments.countByCourse(status);
+}
+
+std::size_t EnrollmentManager::countWithStatus(Enrollment::Status status) const {
+    SES_TIME_OPERATION(CountWithStatus);
+    return m_enrollments.count(status);
+}
+
 bool EnrollmentManager::hasPrerequisites(std::int32_t studentId, std::int32_t courseId) const {
+    SES_TIME_OPERATION(HasPrerequisites);
+    Epoch::Guard guard;
     const Course* course = m_courses.findCourse(courseId);
     if (!course || course->prerequisites().empty()) {
         return true; // No prerequisites required
     }
-    
-    auto completedCourses = getCompletedCourses(studentId);
-    
-    // Check if all prerequisites are satisfied
-    for (std::int32_t prereqId : course->prerequisites()) {
-        if (completedCourses.find(prereqId) == completedCourses.end()) {
-            return false;
-        }
-    }
-    return true;
+
+    CourseState& state = courseState(courseId);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return meetsPrerequisitesLocked(*course, state, studentId);
 }
 
 std::vector<std::int32_t> EnrollmentManager::getMissingPrerequisites(std::int32_t studentId, std::int32_t courseId) const {
+    SES_TIME_OPERATION(MissingPrerequisites);
+    Epoch::Guard guard;
     std::vector<std::int32_t> missing;
     const Course* course = m_courses.findCourse(courseId);
     if (!course) {
         return missing;
     }
-    
-    auto completedCourses = getCompletedCourses(studentId);
-    
+
+    StudentState* student = findState(studentId, m_studentIndex, m_studentStates);
+    std::unique_lock<std::mutex> lock;
+    if (student) {
+        lock = std::unique_lock<std::mutex>(student->mutex);
+    }
     for (std::int32_t prereqId : course->prerequisites()) {
-        if (completedCourses.find(prereqId) == completedCourses.end()) {
+        // A course without state has never been completed by anyone.
+        const CourseState* prereq = findState(prereqId, m_courseIndex, m_courseStates);
+        if (!student || !prereq || !student->completed.test(prereq->slot)) {
             missing.push_back(prereqId);
         }
     }
     return missing;
 }
 
-bool EnrollmentManager::isAlreadyEnrolled(std::int32_t studentId, std::int32_t courseId) const {
-    return std::any_of(m_enrollments.begin(), m_enrollments.end(),
-        [studentId, courseId](const std::unique_ptr<Enrollment>& enrollment) {
-            return enrollment->studentId() == studentId && 
-                   enrollment->courseId() == courseId && 
-                   enrollment->isActive();
-        });
+PrerequisiteGraph::Chain EnrollmentManager::getPrerequisiteChain(std::int32_t studentId, std::int32_t courseId) const {
+    SES_TIME_OPERATION(PrerequisiteChain);
+    StudentState* student = findState(studentId, m_studentIndex, m_studentStates);
+    std::unique_lock<std::mutex> lock;
+    if (student) {
+        lock = std::unique_lock<std::mutex>(student->mutex);
+    }
+    return m_courses.prerequisiteGraph().missingChain(courseId, [&](std::int32_t prereqId) {
+        const CourseState* prereq = findState(prereqId, m_courseIndex, m_courseStates);
+        return student && prereq && student->completed.test(prereq->slot);
+    });
+}
+
+bool EnrollmentManager::meetsPrerequisitesLocked(const Course& course, CourseState& state, std::int32_t studentId) const {
+    if (course.prerequisites().empty()) {
+        return true;
+    }
+    const CourseBitset& required = prerequisiteMaskLocked(course, state);
+    StudentState* student = findState(studentId, m_studentIndex, m_studentStates);
+    if (!student) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(student->mutex);
+    return student->completed.containsAll(required);
+}
+
+bool EnrollmentManager::hasFreeSeat(const Course& course, const CourseState& state) const {
+    return !course.hasCapacityLimit() || state.activeCount.load(std::memory_order_relaxed) < course.capacity();
+}
+
+void EnrollmentManager::appendRowLocked(CourseState& course, const Enrollment& enrollment, std::uint8_t credits) {
+    VersionCounter::Change change(m_version);
+    const std::size_t row = m_enrollments.append(enrollment);
+    indexRowLocked(course, enrollment, row, credits);
 }
 
-std::unordered_set<std::int32_t> EnrollmentManager::getCompletedCourses(std::int32_t studentId) const {
-    std::unordered_set<std::int32_t> completed;
-    for (const auto& enrollment : m_enrollments) {
-        if (enrollment->studentId() == studentId && enrollment->isCompleted()) {
-            completed.insert(enrollment->courseId());
+void EnrollmentManager::indexRowLocked(CourseState& course, const Enrollment& enrollment, std::size_t row,
+                                       std::uint8_t credits) {
+    if (enrollment.isActive()) {
+        course.activeRows[enrollment.studentId()] = ActiveRow{row, credits};
+        course.activeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    course.rows.push_back(row);
+
+    StudentState& student = studentState(enrollment.studentId());
+    {
+        std::lock_guard<std::mutex> lock(student.mutex);
+        student.rows.push_back(row);
+        if (enrollment.isCompleted()) {
+            student.completed.set(course.slot);
         }
     }
-    return completed;
-} 
\ No newline at end of file
+
+    if (m_aggregates) {
+        m_aggregates->enrollmentAdded(enrollment.studentId(), enrollment.courseId(), enrollment.status(), credits);
+    }
+    if (m_log) {
+        m_log->enrollmentAdded(enrollment);
+    }
+}
+
+const CourseBitset& EnrollmentManager::prerequisiteMaskLocked(const Course& course, CourseState& state) const {
+    PrerequisiteMask& entry = state.prerequisites;
+    if (entry.stamp != course.prerequisitesStamp()) {
+        entry.mask.clear();
+        for (std::int32_t prereqId : course.prerequisites()) {
+            entry.mask.set(courseState(prereqId).slot);
+        }
+        entry.stamp = course.prerequisitesStamp();
+    }
+    return entry.mask;
+}
+
+template <typename State>
+State& EnrollmentManager::stateFor(std::int32_t id, ConcurrentIdMap& index, ObjectPool<State, 256>& pool) const {
+    std::uint32_t handle;
+    if (!index.find(id, handle)) {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        if (!index.find(id, handle)) {
+            handle = pool.create();
+            if constexpr (std::is_same_v<State, CourseState>) {
+                pool.get(handle)->slot = handle;
+            }
+            index.insert(id, handle);
+        }
+    }
+    return *pool.get(handle);
+}
+
+template <typename State>
+State* EnrollmentManager::findState(std::int32_t id, const ConcurrentIdMap& index,
+                                    const ObjectPool<State, 256>& pool) const {
+    std::uint32_t handle;
+    return index.find(id, handle) ? pool.get(handle) : nullptr;
+}
@@ -1,14 +1,40 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <memory>
-#include <unordered_set>
+#include <mutex>
+#include <unordered_map>
 #include <functional>
+#include <iterator>
+#include <utility>
+#include "ConcurrentIdMap.h"
+#include "CourseBitset.h"
 #include "Enrollment.h"
+#include "EnrollmentTable.h"
 #include "StudentRegistry.h"
 #include "CourseRegistry.h"
+#include "WaitlistManager.h"
+#include "Metrics.h"
+#include "MutationLog.h"
+#include "ObjectPool.h"
+#include "ReportAggregates.h"
+#include "VersionCounter.h"
 
-// Manages all enrollment operations including prerequisite validation
+// Manages all enrollment operations including prerequisite validation.
+//
+// Thread-safe. Every course has its own lock, so enrollments, drops and
+// promotions in different courses run in parallel; a student's lock guards
+// only their completed-course set and row list and is held briefly. Seat
+// counts are atomics readable without a lock. Registry lookups are lock-free
+// (see StudentRegistry), and so are appends to and status changes in the
+// columnar table (see EnrollmentTable); no lock is shared by all courses.
+// Locks are taken course -> student -> waitlist, never the reverse.
+//
+// Change a registered course's capacity with setCapacity(). Course and
+// Student setters are not synchronized with enrollment and must not run
+// while other threads enroll.
 class EnrollmentManager {
 public:
     enum class EnrollmentResult {
@@ -20,27 +46,206 @@ public:
         CourseFull
     };
 
+    // Enrollments in insertion order, materialized one row at a time while
+    // iterating. Covers the rows that existed when it was made; rows are
+    // never removed, so it stays valid while others enroll, but statuses
+    // are read as they are when each row is visited.
+    class EnrollmentView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Enrollment;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Enrollment;
+
+            iterator(const EnrollmentTable* table, std::size_t row) : m_table(table), m_row(row) {}
+
+            Enrollment operator*() const { return m_table->row(m_row); }
+            // Row index of the current enrollment, a stable cursor.
+            std::size_t row() const noexcept { return m_row; }
+            iterator& operator++() { ++m_row; return *this; }
+            bool operator==(const iterator& other) const { return m_row == other.m_row; }
+            bool operator!=(const iterator& other) const { return m_row != other.m_row; }
+
+        private:
+            const EnrollmentTable* m_table;
+            std::size_t m_row;
+        };
+
+        EnrollmentView(const EnrollmentTable& table, std::size_t first, std::size_t last)
+            : m_table(&table), m_first(first), m_last(last) {}
+
+        iterator begin() const { return iterator(m_table, m_first); }
+        iterator end() const { return iterator(m_table, m_last); }
+        bool empty() const noexcept { return m_first == m_last; }
+        std::size_t size() const noexcept { return m_last - m_first; }
+
+    private:
+        const EnrollmentTable* m_table;
+        std::size_t m_first;
+        std::size_t m_last;
+    };
+
     EnrollmentManager(const StudentRegistry& students, const CourseRegistry& courses);
 
-    // Core enrollment operations
+    // Core enrollment operations. When the course is at capacity,
+    // enrollStudent returns CourseFull and puts the student on the course's
+    // waitlist (if a WaitlistManager is attached). dropStudent frees the
+    // seat and promotes from the waitlist in the same call.
     EnrollmentResult enrollStudent(std::int32_t studentId, std::int32_t courseId);
     bool dropStudent(std::int32_t studentId, std::int32_t courseId);
+
+    // Enrolls many (studentId, courseId) pairs at once. results[i] is what
+    // enrollStudent(requests[i]) would have returned had the requests been
+    // made one after another, with the same waitlist side effects. Requests
+    // are grouped by course, so each course is looked up, locked and has its
+    // seats allocated once per batch; each student is looked up and has
+    // their completed set read once.
+    using EnrollRequest = std::pair<std::int32_t, std::int32_t>;
+    std::vector<EnrollmentResult> enrollBatch(const std::vector<EnrollRequest>& requests);
+
+    // Moves the student's active enrollment in the course to `status`
+    // (Completed, Dropped or Withdrawn). Returns false if there is no active
+    // enrollment or `status` is Active. Does not promote from the waitlist.
+    bool setEnrollmentStatus(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status);
+
+    // Fills free seats in the course from the front of its waitlist.
+    // Waitlisted students who are gone, already enrolled, or no longer meet
+    // the prerequisites are removed from the waitlist and skipped. Returns
+    // the number of students enrolled.
+    std::size_t promoteFromWaitlist(std::int32_t courseId);
+
+    // Sets the course's seat limit (Course::kUnlimitedCapacity for none, 0
+    // to close it) and promotes from the waitlist into any seats it frees.
+    // Lowering it below the active count keeps existing enrollments. Returns
+    // false for an unknown course.
+    bool setCapacity(std::int32_t courseId, std::uint16_t capacity);
+
+    // Seat accounting, O(1). seatsRemaining is kUnlimitedSeats for courses
+    // without a capacity limit and 0 for unknown or over-full courses.
+    static constexpr std::size_t kUnlimitedSeats = SIZE_MAX;
+    std::size_t activeEnrollmentCount(std::int32_t courseId) const;
+    std::size_t seatsRemaining(std::int32_t courseId) const;
     
-    // Query operations
-    std::vector<const Enrollment*> getStudentEnrollments(std::int32_t studentId) const;
-    std::vector<const Enrollment*> getCourseEnrollments(std::int32_t courseId) const;
-    std::vector<const Enrollment*> getAllEnrollments() const;
+    // Query operations. Enrollments are returned by value, materialized
+    // from the columnar table.
+    std::vector<Enrollment> getStudentEnrollments(std::int32_t studentId) const;
+    std::vector<Enrollment> getCourseEnrollments(std::int32_t courseId) const;
+    std::vector<Enrollment> getAllEnrollments() const;
+    // Up to `limit` enrollments from row `fromRow` on, in insertion order,
+    // without copying. Rows are never removed, so the next page starts at
+    // fromRow + limit.
+    EnrollmentView enrollmentsPage(std::size_t fromRow, std::size_t limit) const;
+    // Ids of the courses the student has completed, plus those they are
+    // enrolled in now if `includeActive`.
+    std::vector<std::int32_t> getCompletedCourses(std::int32_t studentId, bool includeActive = false) const;
+    std::size_t enrollmentCount() const;
+    // Number of new enrollments and status changes made, or
+    // VersionCounter::kChanging while one is under way; two equal readings
+    // mean nothing changed in between. See VersionCounter.
+    std::uint64_t version() const noexcept { return m_version.read(); }
+
+    // Report queries: one scan over the courseId column gated by the status bitmap.
+    std::unordered_map<std::int32_t, std::size_t> countByCourse(Enrollment::Status status) const;
+    std::size_t countWithStatus(Enrollment::Status status) const;
+
+    // Read-only access to the columns for analytical scans: calls
+    // fn(const EnrollmentTable&). Rows appended meanwhile are not visited
+    // unless the scan re-reads size().
+    template <typename Fn>
+    decltype(auto) withTable(Fn&& fn) const {
+        return fn(m_enrollments);
+    }
+
+    // Bulk-load support: inserts a recorded enrollment as-is, skipping
+    // student/course/prerequisite validation. Returns false only if it would
+    // create a second active enrollment for the same student and course.
+    bool restoreEnrollment(const Enrollment& enrollment);
+    void reserve(std::size_t count);
+
+    // Reports new enrollments and status changes to `log` (not owned; nullptr to detach).
+    void setMutationLog(MutationLog* log) noexcept { m_log = log; }
+
+    // Waitlists used for full courses (not owned; nullptr to detach).
+    void setWaitlistManager(WaitlistManager* waitlists) noexcept { m_waitlists = waitlists; }
+
+    // Keeps `aggregates` current with every new enrollment and status change
+    // (not owned; nullptr to detach). Attach before loading data.
+    void setAggregates(ReportAggregates* aggregates) noexcept { m_aggregates = aggregates; }
     
     // Prerequisite validation
     bool hasPrerequisites(std::int32_t studentId, std::int32_t courseId) const;
     std::vector<std::int32_t> getMissingPrerequisites(std::int32_t studentId, std::int32_t courseId) const;
+    // Every direct or transitive prerequisite the student has not completed,
+    // in an order they can be taken; see PrerequisiteGraph::missingChain.
+    PrerequisiteGraph::Chain getPrerequisiteChain(std::int32_t studentId, std::int32_t courseId) const;
 
 private:
+    // Completed-course sets and prerequisite lists are bitsets over dense
+    // course slots, so a prerequisite check is a handful of word ANDs. A
+    // course's slot is the handle of its CourseState.
+    struct PrerequisiteMask {
+        std::uint64_t stamp = 0;   // Course::prerequisitesStamp() the mask was built from
+        CourseBitset mask;
+    };
+
+    struct ActiveRow {
+        std::size_t row;
+        std::uint8_t credits;   // charged to the student's load when enrolled
+    };
+
+    struct CourseState {
+        std::mutex mutex;
+        std::uint32_t slot = 0;
+        std::atomic<std::uint32_t> activeCount{0};                 // the seat counter
+        std::unordered_map<std::int32_t, ActiveRow> activeRows;    // studentId -> active row
+        std::vector<std::size_t> rows;                             // every row for the course
+        PrerequisiteMask prerequisites;
+    };
+
+    struct StudentState {
+        std::mutex mutex;
+        std::vector<std::size_t> rows;                             // every row for the student
+        CourseBitset completed;
+    };
+
     const StudentRegistry& m_students;
     const CourseRegistry& m_courses;
-    std::vector<std::unique_ptr<Enrollment>> m_enrollments;
-    
-    // Helper methods
-    bool isAlreadyEnrolled(std::int32_t studentId, std::int32_t courseId) const;
-    std::unordered_set<std::int32_t> getCompletedCourses(std::int32_t studentId) const;
-}; 
\ No newline at end of file
+    // Columnar enrollment rows. Rows are never erased, so row indices stay
+    // valid for the manager's lifetime.
+    EnrollmentTable m_enrollments;
+    MutationLog* m_log = nullptr;
+    WaitlistManager* m_waitlists = nullptr;
+    ReportAggregates* m_aggregates = nullptr;
+    VersionCounter m_version;
+
+    // Per-course and per-student state, created on first use and never
+    // destroyed, so references stay valid without holding any lock. Lookups
+    // are lock-free; creation serializes on m_stateMutex.
+    mutable ObjectPool<CourseState, 256> m_courseStates;
+    mutable ObjectPool<StudentState, 256> m_studentStates;
+    mutable ConcurrentIdMap m_courseIndex;
+    mutable ConcurrentIdMap m_studentIndex;
+    mutable std::mutex m_stateMutex;
+
+    template <typename State>
+    State& stateFor(std::int32_t id, ConcurrentIdMap& index, ObjectPool<State, 256>& pool) const;
+    template <typename State>
+    State* findState(std::int32_t id, const ConcurrentIdMap& index, const ObjectPool<State, 256>& pool) const;
+    CourseState& courseState(std::int32_t courseId) const { return stateFor(courseId, m_courseIndex, m_courseStates); }
+    StudentState& studentState(std::int32_t studentId) const { return stateFor(studentId, m_studentIndex, m_studentStates); }
+
+    // Helper methods; the *Locked ones require the course's mutex, and
+    // indexRowLocked an open VersionCounter::Change as well.
+    EnrollmentResult enrollChecked(std::int32_t studentId, std::int32_t courseId);
+    bool setStatusLocked(CourseState& course, std::int32_t studentId, std::int32_t courseId, Enrollment::Status status);
+    std::size_t promoteLocked(const Course& course, CourseState& state);
+    bool meetsPrerequisitesLocked(const Course& course, CourseState& state, std::int32_t studentId) const;
+    bool hasFreeSeat(const Course& course, const CourseState& state) const;
+    void appendRowLocked(CourseState& course, const Enrollment& enrollment, std::uint8_t credits);
+    void indexRowLocked(CourseState& course, const Enrollment& enrollment, std::size_t row, std::uint8_t credits);
+    const CourseBitset& prerequisiteMaskLocked(const Course& course, CourseState& state) const;
+    std::vector<Enrollment> activeRows(std::vector<std::size_t> rows) const;
+};
\ No newline at end of file
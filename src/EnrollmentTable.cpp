@@ -0,0 +1,144 @@
+#include "EnrollmentTable.h"
+#include "BitOps.h"
+
+namespace {
+
+// Calls fn(firstRow + i) for every set bit i of the `words` words of `bits`, in order.
+template <typename Fn>
+void forEachSetBit(const std::uint64_t* bits, std::size_t words, std::size_t firstRow, Fn&& fn) {
+    for (std::size_t w = 0; w < words; ++w) {
+        for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+            fn(firstRow + w * 64 + lowestBit(word));
+        }
+    }
+}
+
+} // namespace
+
+std::size_t EnrollmentTable::append(const Enrollment* enrollments, std::size_t count) {
+    const std::size_t first = m_reserved.fetch_add(count, std::memory_order_relaxed);
+    for (std::size_t k = 0; k < count; ++k) {
+        const Enrollment& enrollment = enrollments[k];
+        const std::size_t row = first + k;
+        const std::uint64_t bit = std::uint64_t{1} << (row % 64);
+        m_studentIds.grow(row) = enrollment.studentId();
+        m_courseIds.grow(row) = enrollment.courseId();
+        m_dates.grow(row) = enrollment.enrollmentDate();
+        m_statuses.grow(row).store(static_cast<std::uint8_t>(enrollment.status()), std::memory_order_relaxed);
+        m_statusBits[static_cast<std::size_t>(enrollment.status())].grow(row / 64).fetch_or(bit, std::memory_order_relaxed);
+        m_written.grow(row / 64).fetch_or(bit, std::memory_order_seq_cst);
+    }
+    publish();
+    return first;
+}
+
+std::size_t EnrollmentTable::writtenEnd(std::size_t from) const noexcept {
+    std::size_t end = from;
+    for (;;) {
+        if (end == kMaxChunks * kChunkRows) return end;
+        const std::atomic<std::uint64_t>* written = m_written.chunk(end / kChunkRows);
+        if (!written) return end;
+        const std::uint64_t unwritten = ~written[end % kChunkRows / 64].load(std::memory_order_seq_cst) >> (end % 64);
+        if (unwritten != 0) return end + lowestBit(unwritten);
+        end += 64 - end % 64;
+    }
+}
+
+void EnrollmentTable::publish() {
+    // Any writer may move size() over rows that others have written. A
+    // writer marks its rows before reading size() and a publisher reads the
+    // marks after it last saw size(), so (all of it being seq_cst) whoever
+    // finishes the last row of a run sees the run and publishes it.
+    std::size_t published = m_size.load(std::memory_order_seq_cst);
+    for (;;) {
+        const std::size_t end = writtenEnd(published);
+        if (end == published) return;
+        if (m_size.compare_exchange_weak(published, end, std::memory_order_seq_cst)) {
+            published = end;
+        }
+    }
+}
+
+void EnrollmentTable::setStatus(std::size_t row, Enrollment::Status status) {
+    const std::uint64_t bit = std::uint64_t{1} << (row % 64);
+    const std::uint8_t previous = m_statuses[row].load(std::memory_order_relaxed);
+    m_statusBits[previous][row / 64].fetch_and(~bit, std::memory_order_relaxed);
+    m_statusBits[static_cast<std::size_t>(status)].grow(row / 64).fetch_or(bit, std::memory_order_relaxed);
+    m_statuses[row].store(static_cast<std::uint8_t>(status), std::memory_order_relaxed);
+}
+
+void EnrollmentTable::reserve(std::size_t count) {
+    m_studentIds.reserve(count);
+    m_courseIds.reserve(count);
+    m_dates.reserve(count);
+    m_statuses.reserve(count);
+    m_statusBits[static_cast<std::size_t>(Enrollment::Status::Active)].reserve((count + 63) / 64);
+    m_written.reserve((count + 63) / 64);
+}
+
+Enrollment EnrollmentTable::row(std::size_t row) const {
+    return Enrollment(m_studentIds[row], m_courseIds[row], status(row), m_dates[row]);
+}
+
+void EnrollmentTable::loadMask(std::size_t chunk, Enrollment::Status status, std::size_t count,
+                               std::uint64_t* mask) const noexcept {
+    const std::atomic<std::uint64_t>* bits = m_statusBits[static_cast<std::size_t>(status)].chunk(chunk);
+    const std::size_t words = (count + 63) / 64;
+    for (std::size_t w = 0; w < words; ++w) {
+        mask[w] = bits ? bits[w].load(std::memory_order_relaxed) : 0;
+    }
+    if (count % 64 != 0) {
+        mask[words - 1] &= (std::uint64_t{1} << (count % 64)) - 1;
+    }
+}
+
+std::size_t EnrollmentTable::count(Enrollment::Status status) const noexcept {
+    std::size_t total = 0;
+    forEachBlock([&](const Block& block) {
+        std::uint64_t mask[kChunkWords];
+        loadMask(block.firstRow / kChunkRows, status, block.count, mask);
+        for (std::size_t w = 0; w < (block.count + 63) / 64; ++w) {
+            total += popCount(mask[w]);
+        }
+    });
+    return total;
+}
+
+std::vector<std::size_t> EnrollmentTable::rowsWithStatus(Enrollment::Status status) const {
+    std::vector<std::size_t> rows;
+    forEachBlock([&](const Block& block) {
+        std::uint64_t mask[kChunkWords];
+        loadMask(block.firstRow / kChunkRows, status, block.count, mask);
+        forEachSetBit(mask, (block.count + 63) / 64, block.firstRow, [&rows](std::size_t row) { rows.push_back(row); });
+    });
+    return rows;
+}
+
+std::unordered_map<std::int32_t, std::size_t> EnrollmentTable::countByCourse(Enrollment::Status status) const {
+    return countByKey(Column::CourseId, status);
+}
+
+std::unordered_map<std::int32_t, std::size_t> EnrollmentTable::countByStudent(Enrollment::Status status) const {
+    return countByKey(Column::StudentId, status);
+}
+
+std::unordered_map<std::int32_t, std::size_t> EnrollmentTable::countByKey(Column column,
+                                                                          Enrollment::Status status) const {
+    std::unordered_map<std::int32_t, std::size_t> counts;
+    forEachBlock([&](const Block& block) {
+        std::uint64_t mask[kChunkWords];
+        loadMask(block.firstRow / kChunkRows, status, block.count, mask);
+        const std::int32_t* keys = column == Column::StudentId ? block.studentIds : block.courseIds;
+        for (std::size_t w = 0; w < (block.count + 63) / 64; ++w) {
+            const std::uint64_t word = mask[w];
+            if (word == 0) continue;
+            const std::int32_t* run = keys + w * 64;
+            if (word == ~std::uint64_t{0}) {
+                for (std::size_t i = 0; i < 64; ++i) ++counts[run[i]];
+            } else {
+                for (std::uint64_t rest = word; rest != 0; rest &= rest - 1) ++counts[run[lowestBit(rest)]];
+            }
+        }
+    });
+    return counts;
+}
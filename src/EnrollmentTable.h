@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Enrollment.h"
+#include "SlabVector.h"
+
+// Column-oriented enrollment storage.
+//
+// Each field lives in its own contiguous array indexed by row, and every
+// status has a bitmap with one bit per row. Analytical queries ("active
+// enrollments per course", "completed per student") read only the columns
+// they need, and status filters reduce to word-wide bitmap operations.
+// Rows are append-only; only their status changes after insertion, so row
+// indices are stable handles.
+//
+// Every column is a SlabVector of kChunkRows-row chunks (kChunkWords-word
+// chunks for the bitmaps) that never move, so appending needs no lock: a
+// writer reserves rows with an atomic counter,
+// fills them in, and marks them written. size() counts the rows written
+// without a gap, and readers see only those. setStatus() may run in
+// parallel for different rows; changes to one row must be serialized by
+// the caller (EnrollmentManager holds the course lock).
+class EnrollmentTable final {
+public:
+    static constexpr std::size_t kStatusCount = 4;
+    static constexpr std::size_t kChunkRows = std::size_t{1} << 14;
+
+    EnrollmentTable() = default;
+
+    EnrollmentTable(const EnrollmentTable&) = delete;
+    EnrollmentTable& operator=(const EnrollmentTable&) = delete;
+
+    std::size_t append(const Enrollment& enrollment) { return append(&enrollment, 1); }
+    // Appends `count` rows with consecutive indices; returns the first.
+    std::size_t append(const Enrollment* enrollments, std::size_t count);
+    void setStatus(std::size_t row, Enrollment::Status status);
+    // Allocates the chunks for `count` rows up front.
+    void reserve(std::size_t count);
+
+    std::size_t size() const noexcept { return m_size.load(std::memory_order_acquire); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Materializes one row.
+    Enrollment row(std::size_t row) const;
+
+    std::int32_t studentId(std::size_t row) const noexcept { return m_studentIds[row]; }
+    std::int32_t courseId(std::size_t row) const noexcept { return m_courseIds[row]; }
+    Enrollment::Status status(std::size_t row) const noexcept {
+        return static_cast<Enrollment::Status>(m_statuses[row].load(std::memory_order_relaxed));
+    }
+    std::chrono::system_clock::time_point enrollmentDate(std::size_t row) const noexcept { return m_dates[row]; }
+
+    // Filters and aggregates over the columns. Lookups by one student or
+    // course go through EnrollmentManager's per-key row lists instead.
+    std::size_t count(Enrollment::Status status) const noexcept;
+    std::vector<std::size_t> rowsWithStatus(Enrollment::Status status) const;
+    std::unordered_map<std::int32_t, std::size_t> countByCourse(Enrollment::Status status) const;
+    std::unordered_map<std::int32_t, std::size_t> countByStudent(Enrollment::Status status) const;
+
+    // One chunk's worth of consecutive rows, [firstRow, firstRow + count).
+    struct Block {
+        std::size_t firstRow;
+        std::size_t count;
+        const std::int32_t* studentIds;
+        const std::int32_t* courseIds;
+        const std::chrono::system_clock::time_point* dates;
+    };
+    // Calls fn(const Block&) for the rows of size(), in row order.
+    template <typename Fn>
+    void forEachBlock(Fn&& fn) const {
+        const std::size_t rows = size();
+        for (std::size_t first = 0; first < rows; first += kChunkRows) {
+            const std::size_t chunk = first / kChunkRows;
+            fn(Block{first, std::min(kChunkRows, rows - first), m_studentIds.chunk(chunk), m_courseIds.chunk(chunk),
+                     m_dates.chunk(chunk)});
+        }
+    }
+
+private:
+    enum class Column { StudentId, CourseId };
+
+    static constexpr std::size_t kChunkWords = kChunkRows / 64;
+    static constexpr std::size_t kMaxChunks = std::size_t{1} << 14;   // capacity: 2^28 rows
+
+    template <typename T>
+    using RowColumn = SlabVector<T, kChunkRows, kMaxChunks>;
+    // One bit per row, so chunk i covers the same rows as chunk i of a RowColumn.
+    using BitColumn = SlabVector<std::atomic<std::uint64_t>, kChunkWords, kMaxChunks>;
+
+    // First row at or after `from` that has not been written.
+    std::size_t writtenEnd(std::size_t from) const noexcept;
+    void publish();
+
+    // Copies the status bits of chunk `chunk`'s first `count` rows, with
+    // the bits past them cleared.
+    void loadMask(std::size_t chunk, Enrollment::Status status, std::size_t count, std::uint64_t* mask) const noexcept;
+    std::unordered_map<std::int32_t, std::size_t> countByKey(Column column, Enrollment::Status status) const;
+
+    RowColumn<std::int32_t> m_studentIds;
+    RowColumn<std::int32_t> m_courseIds;
+    RowColumn<std::chrono::system_clock::time_point> m_dates;
+    RowColumn<std::atomic<std::uint8_t>> m_statuses;
+    std::array<BitColumn, kStatusCount> m_statusBits;   // chunks allocated on the first row with that status
+    BitColumn m_written;                                // rows filled in, for publishing size()
+    std::atomic<std::size_t> m_reserved{0};   // rows handed out to writers
+    std::atomic<std::size_t> m_size{0};       // rows written, without gaps
+};
@@ -0,0 +1,86 @@
+#include "Epoch.h"
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t kMaxThreads = 512;
+
+struct alignas(64) ThreadRecord {
+    std::atomic<std::uint64_t> pinned{0};   // epoch observed by the outermost guard, 0 when idle
+    std::atomic<bool> inUse{false};
+    unsigned depth = 0;                     // touched only by the owning thread
+};
+
+ThreadRecord g_records[kMaxThreads];
+std::atomic<std::size_t> g_recordsUsed{0};   // high-water mark of claimed records
+std::atomic<std::uint64_t> g_epoch{1};
+
+// Claims a record for the calling thread and hands it back on thread exit.
+struct Registration {
+    ThreadRecord* record = nullptr;
+
+    ~Registration() {
+        if (record) {
+            record->inUse.store(false, std::memory_order_release);
+        }
+    }
+
+    ThreadRecord& get() {
+        while (!record) {
+            for (std::size_t i = 0; i < kMaxThreads; ++i) {
+                bool expected = false;
+                if (g_records[i].inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                    record = &g_records[i];
+                    std::size_t used = g_recordsUsed.load(std::memory_order_relaxed);
+                    while (used < i + 1 &&
+                           !g_recordsUsed.compare_exchange_weak(used, i + 1, std::memory_order_seq_cst)) {
+                    }
+                    break;
+                }
+            }
+            if (!record) {
+                std::this_thread::yield();   // more live threads than records; wait for one to exit
+            }
+        }
+        return *record;
+    }
+};
+
+thread_local Registration t_registration;
+
+} // namespace
+
+Epoch::Guard::Guard() noexcept {
+    ThreadRecord& self = t_registration.get();
+    if (self.depth++ == 0) {
+        self.pinned.store(g_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        // Pairs with the fence in isReclaimable: either the writer sees this
+        // pin, or every load below sees the writer's unlink.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+Epoch::Guard::~Guard() {
+    ThreadRecord& self = t_registration.get();
+    if (--self.depth == 0) {
+        self.pinned.store(0, std::memory_order_release);
+    }
+}
+
+std::uint64_t Epoch::retire() noexcept {
+    return g_epoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool Epoch::isReclaimable(std::uint64_t stamp) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::size_t used = g_recordsUsed.load(std::memory_order_seq_cst);
+    for (std::size_t i = 0; i < used; ++i) {
+        const std::uint64_t pinned = g_records[i].pinned.load(std::memory_order_acquire);
+        if (pinned != 0 && pinned <= stamp) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Process-wide epoch-based reclamation (a lightweight RCU).
+//
+// Readers hold an Epoch::Guard while they use pointers obtained from a
+// concurrent structure; a guard costs a thread-local store and a fence, and
+// never blocks. A writer that unlinks an object takes a stamp with
+// Epoch::retire() and keeps the object alive until
+// Epoch::isReclaimable(stamp) reports that every reader that might still
+// see it has left its guard. Guards nest; only the outermost one pins.
+class Epoch final {
+public:
+    class Guard {
+    public:
+        Guard() noexcept;
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // Call after unlinking an object; returns the stamp to free it under.
+    static std::uint64_t retire() noexcept;
+
+    // True once no guard that was active at retire() time remains.
+    static bool isReclaimable(std::uint64_t stamp) noexcept;
+};
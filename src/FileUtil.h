@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+// Small platform layer for the persistence code: durable flushes, atomic
+// replace, and read-only memory mapping. POSIX and Win32 are supported.
+
+// Flushes stdio buffers and asks the OS to push the file to stable storage.
+bool syncFile(std::FILE* file);
+
+// Atomically replaces `target` with `source` (rename over). Both must be on
+// the same filesystem.
+bool replaceFile(const std::string& source, const std::string& target);
+
+// Read-only view of an entire file. The mapping lives as long as the object.
+class MappedFile final {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Maps `path`. Returns false if it cannot be opened or mapped.
+    bool open(const std::string& path);
+    void close() noexcept;
+
+    const unsigned char* data() const noexcept { return m_data; }
+    std::size_t size() const noexcept { return m_size; }
+    bool isOpen() const noexcept { return m_open; }
+
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <shared_mutex>
+#include <utility>
+#include "ObjectPool.h"
+
+// Entry of an id-ordered index, for paging through a registry by id.
+struct IdIndexEntry {
+    std::int32_t id;
+    std::uint32_t handle;
+
+    bool operator<(const IdIndexEntry& other) const noexcept { return id < other.id; }
+};
+
+// `it` moved forward `count` times, or to `end` if that comes first.
+template <typename Iterator>
+Iterator advanceAtMost(Iterator it, Iterator end, std::size_t count) {
+    for (; count > 0 && it != end; --count) ++it;
+    return it;
+}
+
+// Iterable view of [first, last) of an ordered secondary index whose
+// entries carry a pool `handle`; dereferencing yields the pooled object
+// itself, so a filtered listing is walked in index order without copying
+// anything into a vector.
+//
+// The view holds its owner's index lock for reading until it is destroyed.
+// Keep it short-lived, and do not call anything on the owner that writes
+// (or that waits for writers) while it is alive.
+template <typename Iterator, typename T>
+class IndexView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+        iterator(Iterator it, const ObjectPool<T>* pool) : m_it(it), m_pool(pool) {}
+
+        reference operator*() const { return *m_pool->get(m_it->handle); }
+        pointer operator->() const { return m_pool->get(m_it->handle); }
+        iterator& operator++() { ++m_it; return *this; }
+        iterator operator++(int) { iterator old = *this; ++m_it; return old; }
+        bool operator==(const iterator& other) const { return m_it == other.m_it; }
+        bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+    private:
+        Iterator m_it{};
+        const ObjectPool<T>* m_pool = nullptr;
+    };
+
+    IndexView(std::shared_lock<std::shared_mutex> lock, Iterator first, Iterator last, const ObjectPool<T>& pool)
+        : m_lock(std::move(lock)), m_first(first), m_last(last), m_pool(&pool) {}
+
+    iterator begin() const { return iterator(m_first, m_pool); }
+    iterator end() const { return iterator(m_last, m_pool); }
+    bool empty() const { return m_first == m_last; }
+    // Linear in the view's length for node-based indexes.
+    std::size_t size() const { return static_cast<std::size_t>(std::distance(m_first, m_last)); }
+
+private:
+    std::shared_lock<std::shared_mutex> m_lock;
+    Iterator m_first;
+    Iterator m_last;
+    const ObjectPool<T>* m_pool;
+};
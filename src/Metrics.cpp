@@ -0,0 +1,289 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include "BitOps.h"
+
+namespace {
+
+constexpr const char* kOperationNames[Metrics::kOperationCount] = {
+    "student.add", "student.add_batch", "student.remove", "student.find", "student.list", "student.find_by_email", "student.search",
+    "course.add", "course.add_batch", "course.remove", "course.find", "course.list", "course.filter", "course.search",
+    "enroll", "enroll.batch", "drop", "set_status", "set_capacity", "promote", "restore",
+    "seats.active", "seats.remaining", "enrollments.by_student", "enrollments.by_course", "enrollments.all", "enrollments.completed",
+    "count.by_course", "count.with_status", "prerequisites.check", "prerequisites.missing", "prerequisites.chain",
+    "waitlist.add", "waitlist.next", "waitlist.contains", "waitlist.remove", "waitlist.get", "waitlist.find",
+    "waitlist.position", "waitlist.empty", "waitlist.size",
+};
+
+constexpr const char* kCounterNames[Metrics::kCounterCount] = {
+    "enroll.success", "enroll.student_not_found", "enroll.course_not_found",
+    "enroll.prerequisites_not_met", "enroll.already_enrolled", "enroll.course_full",
+};
+
+// Values below kSubBuckets get a bucket each; above that, every power of
+// two is split into kSubBuckets equal steps.
+constexpr std::size_t kSubBits = 4;
+static_assert(Metrics::kSubBuckets == std::size_t{1} << kSubBits, "kSubBuckets must match kSubBits");
+
+inline std::size_t bucketOf(std::uint64_t value) noexcept {
+    if (value < Metrics::kSubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    const std::size_t exponent = highestBit(value);
+    const std::size_t sub = static_cast<std::size_t>(value >> (exponent - kSubBits)) & (Metrics::kSubBuckets - 1);
+    return (exponent - kSubBits + 1) * Metrics::kSubBuckets + sub;
+}
+
+// Midpoint of the values that map to `bucket`.
+inline std::uint64_t valueOf(std::size_t bucket) noexcept {
+    if (bucket < Metrics::kSubBuckets) {
+        return bucket;
+    }
+    const std::size_t exponent = bucket / Metrics::kSubBuckets + kSubBits - 1;
+    const std::size_t sub = bucket % Metrics::kSubBuckets;
+    const std::uint64_t width = std::uint64_t{1} << (exponent - kSubBits);
+    return ((Metrics::kSubBuckets + sub) << (exponent - kSubBits)) + width / 2;
+}
+
+// Single writer (the owning thread), any number of readers. The writer uses
+// load + store rather than read-modify-write, which is all it needs.
+struct Histogram {
+    std::atomic<std::uint64_t> buckets[Metrics::kBucketCount] = {};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+};
+
+inline void bump(std::atomic<std::uint64_t>& cell, std::uint64_t by = 1) noexcept {
+    cell.store(cell.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+struct ThreadMetrics {
+    // Histograms are allocated the first time the thread runs an operation.
+    std::atomic<Histogram*> operations[Metrics::kOperationCount] = {};
+    std::atomic<std::uint64_t> counters[Metrics::kCounterCount] = {};
+
+    ~ThreadMetrics() {
+        for (auto& histogram : operations) {
+            delete histogram.load(std::memory_order_relaxed);
+        }
+    }
+
+    Histogram& histogram(Metrics::Operation operation) {
+        auto& slot = operations[static_cast<std::size_t>(operation)];
+        Histogram* histogram = slot.load(std::memory_order_relaxed);
+        if (!histogram) {
+            histogram = new Histogram();
+            slot.store(histogram, std::memory_order_release);
+        }
+        return *histogram;
+    }
+};
+
+// Live threads plus the totals of threads that have exited.
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadMetrics*> live;
+    ThreadMetrics retired;
+
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+void mergeInto(ThreadMetrics& into, const ThreadMetrics& from) {
+    for (std::size_t op = 0; op < Metrics::kOperationCount; ++op) {
+        const Histogram* source = from.operations[op].load(std::memory_order_acquire);
+        if (!source) continue;
+        Histogram& target = into.histogram(static_cast<Metrics::Operation>(op));
+        for (std::size_t b = 0; b < Metrics::kBucketCount; ++b) {
+            const std::uint64_t n = source->buckets[b].load(std::memory_order_relaxed);
+            if (n != 0) bump(target.buckets[b], n);
+        }
+        bump(target.count, source->count.load(std::memory_order_relaxed));
+        bump(target.sum, source->sum.load(std::memory_order_relaxed));
+        target.max.store(std::max(target.max.load(std::memory_order_relaxed),
+                                  source->max.load(std::memory_order_relaxed)),
+                         std::memory_order_relaxed);
+    }
+    for (std::size_t c = 0; c < Metrics::kCounterCount; ++c) {
+        bump(into.counters[c], from.counters[c].load(std::memory_order_relaxed));
+    }
+}
+
+// Registers the thread's metrics on first use and folds them into the
+// retired totals when the thread exits.
+struct ThreadOwner {
+    std::unique_ptr<ThreadMetrics> metrics;
+
+    ~ThreadOwner() {
+        if (!metrics) return;
+        Registry& registry = Registry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        mergeInto(registry.retired, *metrics);
+        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), metrics.get()));
+    }
+
+    ThreadMetrics& get() {
+        if (!metrics) {
+            metrics = std::make_unique<ThreadMetrics>();
+            Registry& registry = Registry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.live.push_back(metrics.get());
+        }
+        return *metrics;
+    }
+};
+
+thread_local ThreadOwner t_owner;
+
+std::uint64_t percentile(const std::uint64_t* buckets, std::uint64_t count, double p) {
+    if (count == 0) return 0;
+    const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < Metrics::kBucketCount; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return valueOf(b);
+    }
+    return valueOf(Metrics::kBucketCount - 1);
+}
+
+} // namespace
+
+void Metrics::record(Operation operation, std::uint64_t nanoseconds) noexcept {
+    Histogram& histogram = t_owner.get().histogram(operation);
+    bump(histogram.buckets[bucketOf(nanoseconds)]);
+    bump(histogram.count);
+    bump(histogram.sum, nanoseconds);
+    if (nanoseconds > histogram.max.load(std::memory_order_relaxed)) {
+        histogram.max.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::increment(Counter counter) noexcept {
+    bump(t_owner.get().counters[static_cast<std::size_t>(counter)]);
+}
+
+Metrics::Snapshot Metrics::snapshot() {
+    ThreadMetrics total;
+    {
+        Registry& registry = Registry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        mergeInto(total, registry.retired);
+        for (const ThreadMetrics* metrics : registry.live) {
+            mergeInto(total, *metrics);
+        }
+    }
+
+    Snapshot snapshot;
+    snapshot.operations.reserve(kOperationCount);
+    std::vector<std::uint64_t> buckets(kBucketCount);
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        OperationStats stats;
+        stats.name = kOperationNames[op];
+        if (const Histogram* histogram = total.operations[op].load(std::memory_order_relaxed)) {
+            for (std::size_t b = 0; b < kBucketCount; ++b) {
+                buckets[b] = histogram->buckets[b].load(std::memory_order_relaxed);
+            }
+            stats.count = histogram->count.load(std::memory_order_relaxed);
+            stats.meanNs = stats.count == 0 ? 0.0
+                                            : static_cast<double>(histogram->sum.load(std::memory_order_relaxed)) /
+                                                  static_cast<double>(stats.count);
+            stats.p50Ns = percentile(buckets.data(), stats.count, 0.50);
+            stats.p90Ns = percentile(buckets.data(), stats.count, 0.90);
+            stats.p99Ns = percentile(buckets.data(), stats.count, 0.99);
+            stats.p999Ns = percentile(buckets.data(), stats.count, 0.999);
+            stats.maxNs = histogram->max.load(std::memory_order_relaxed);
+        }
+        snapshot.operations.push_back(stats);
+    }
+    snapshot.counters.reserve(kCounterCount);
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        snapshot.counters.push_back({kCounterNames[c], total.counters[c].load(std::memory_order_relaxed)});
+    }
+    return snapshot;
+}
+
+void Metrics::reset() {
+    Registry& registry = Registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto clear = [](ThreadMetrics& metrics) {
+        for (auto& slot : metrics.operations) {
+            if (Histogram* histogram = slot.load(std::memory_order_acquire)) {
+                for (auto& bucket : histogram->buckets) bucket.store(0, std::memory_order_relaxed);
+                histogram->count.store(0, std::memory_order_relaxed);
+                histogram->sum.store(0, std::memory_order_relaxed);
+                histogram->max.store(0, std::memory_order_relaxed);
+            }
+        }
+        for (auto& counter : metrics.counters) counter.store(0, std::memory_order_relaxed);
+    };
+    clear(registry.retired);
+    for (ThreadMetrics* metrics : registry.live) {
+        clear(*metrics);
+    }
+}
+
+const char* Metrics::name(Operation operation) noexcept {
+    return kOperationNames[static_cast<std::size_t>(operation)];
+}
+
+const char* Metrics::name(Counter counter) noexcept {
+    return kCounterNames[static_cast<std::size_t>(counter)];
+}
+
+std::string Metrics::Snapshot::toText() const {
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-24s %10s %10s %10s %10s %10s %10s\n",
+                  "operation", "count", "mean ns", "p50 ns", "p99 ns", "p999 ns", "max ns");
+    out += line;
+    for (const OperationStats& op : operations) {
+        if (op.count == 0) continue;
+        std::snprintf(line, sizeof(line), "%-24s %10llu %10.0f %10llu %10llu %10llu %10llu\n", op.name,
+                      static_cast<unsigned long long>(op.count), op.meanNs,
+                      static_cast<unsigned long long>(op.p50Ns), static_cast<unsigned long long>(op.p99Ns),
+                      static_cast<unsigned long long>(op.p999Ns), static_cast<unsigned long long>(op.maxNs));
+        out += line;
+    }
+    for (const CounterValue& counter : counters) {
+        std::snprintf(line, sizeof(line), "%-28s %10llu\n", counter.name,
+                      static_cast<unsigned long long>(counter.value));
+        out += line;
+    }
+    return out;
+}
+
+std::string Metrics::Snapshot::toJson() const {
+    std::string out = "{\"enabled\":";
+    out += Metrics::enabled() ? "true" : "false";
+    out += ",\"operations\":{";
+    char field[256];
+    bool first = true;
+    for (const OperationStats& op : operations) {
+        if (op.count == 0) continue;
+        std::snprintf(field, sizeof(field),
+                      "%s\"%s\":{\"count\":%llu,\"mean_ns\":%.1f,\"p50_ns\":%llu,\"p90_ns\":%llu,"
+                      "\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu}",
+                      first ? "" : ",", op.name, static_cast<unsigned long long>(op.count), op.meanNs,
+                      static_cast<unsigned long long>(op.p50Ns), static_cast<unsigned long long>(op.p90Ns),
+                      static_cast<unsigned long long>(op.p99Ns), static_cast<unsigned long long>(op.p999Ns),
+                      static_cast<unsigned long long>(op.maxNs));
+        out += field;
+        first = false;
+    }
+    out += "},\"counters\":{";
+    first = true;
+    for (const CounterValue& counter : counters) {
+        std::snprintf(field, sizeof(field), "%s\"%s\":%llu", first ? "" : ",", counter.name,
+                      static_cast<unsigned long long>(counter.value));
+        out += field;
+        first = false;
+    }
+    out += "}}";
+    return out;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Operation latency histograms and outcome counters for the core library.
+//
+// Every public operation of the registries, WaitlistManager and
+// EnrollmentManager is timed with SES_TIME_OPERATION. Each thread records
+// into its own histograms with plain relaxed stores, so recording never
+// contends; Metrics::snapshot() merges all threads. Histograms are
+// HDR-style: power-of-two ranges split into kSubBuckets linear steps, which
+// keeps every recorded value within 1/kSubBuckets of the truth from
+// nanoseconds to minutes.
+//
+// Built with SES_METRICS=0 (CMake -DENABLE_METRICS=OFF) the macros expand to
+// nothing, no clock is read, and snapshot() returns empty statistics.
+class Metrics final {
+public:
+    enum class Operation : std::uint16_t {
+        StudentAdd, StudentAddBatch, StudentRemove, StudentFind, StudentList, StudentFindByEmail, StudentSearch,
+        CourseAdd, CourseAddBatch, CourseRemove, CourseFind, CourseList, CourseFilter, CourseSearch,
+        Enroll, EnrollBatch, Drop, SetStatus, SetCapacity, Promote, Restore,
+        ActiveCount, SeatsRemaining, StudentEnrollments, CourseEnrollments, AllEnrollments, CompletedCourses,
+        CountByCourse, CountWithStatus, HasPrerequisites, MissingPrerequisites, PrerequisiteChain,
+        WaitlistAdd, WaitlistNext, WaitlistContains, WaitlistRemove, WaitlistGet, WaitlistFind,
+        WaitlistPosition, WaitlistEmpty, WaitlistSize,
+        kCount
+    };
+
+    // One counter per EnrollmentManager::EnrollmentResult, in the same order.
+    enum class Counter : std::uint16_t {
+        EnrollSuccess, EnrollStudentNotFound, EnrollCourseNotFound,
+        EnrollPrerequisitesNotMet, EnrollAlreadyEnrolled, EnrollCourseFull,
+        kCount
+    };
+
+    static constexpr std::size_t kOperationCount = static_cast<std::size_t>(Operation::kCount);
+    static constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::kCount);
+    static constexpr std::size_t kSubBuckets = 16;
+    static constexpr std::size_t kBucketCount = 64 * kSubBuckets;
+
+    struct OperationStats {
+        const char* name;
+        std::uint64_t count = 0;
+        double meanNs = 0;
+        std::uint64_t p50Ns = 0;
+        std::uint64_t p90Ns = 0;
+        std::uint64_t p99Ns = 0;
+        std::uint64_t p999Ns = 0;
+        std::uint64_t maxNs = 0;
+    };
+
+    struct CounterValue {
+        const char* name;
+        std::uint64_t value = 0;
+    };
+
+    struct Snapshot {
+        std::vector<OperationStats> operations;   // kOperationCount entries, in Operation order
+        std::vector<CounterValue> counters;       // kCounterCount entries, in Counter order
+
+        std::string toText() const;   // aligned table of operations that ran, then counters
+        std::string toJson() const;
+    };
+
+    static constexpr bool enabled() noexcept {
+#if SES_METRICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static void record(Operation operation, std::uint64_t nanoseconds) noexcept;
+    static void increment(Counter counter) noexcept;
+
+    // Merges every thread's histograms; safe to call while others record.
+    static Snapshot snapshot();
+    // Zeroes all histograms and counters. Records made concurrently may be lost.
+    static void reset();
+
+    static const char* name(Operation operation) noexcept;
+    static const char* name(Counter counter) noexcept;
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Operation operation) noexcept
+            : m_operation(operation), m_start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            const auto elapsed = std::chrono::steady_clock::now() - m_start;
+            record(m_operation, static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Operation m_operation;
+        std::chrono::steady_clock::time_point m_start;
+    };
+};
+
+#if SES_METRICS
+#define SES_METRICS_CONCAT_(a, b) a##b
+#define SES_METRICS_CONCAT(a, b) SES_METRICS_CONCAT_(a, b)
+#define SES_TIME_OPERATION(op) \
+    const Metrics::ScopedTimer SES_METRICS_CONCAT(sesTimer_, __LINE__)(Metrics::Operation::op)
+#define SES_COUNT(counter) Metrics::increment(counter)
+#else
+#define SES_TIME_OPERATION(op) ((void)0)
+#define SES_COUNT(counter) ((void)0)
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include "Student.h"
+#include "Course.h"
+#include "Enrollment.h"
+
+// Receives every successful state change made through the registries and
+// managers. Attach one with setMutationLog(); the default (nullptr) costs a
+// single branch per mutation. Calls happen after the change has been applied,
+// on the thread that made it.
+class MutationLog {
+public:
+    virtual ~MutationLog() = default;
+
+    virtual void studentAdded(const Student& student) = 0;
+    virtual void studentRemoved(std::int32_t studentId) = 0;
+    virtual void studentUpdated(const Student& student) = 0;
+    virtual void courseAdded(const Course& course) = 0;
+    virtual void courseRemoved(std::int32_t courseId) = 0;
+    virtual void coursePrerequisitesChanged(const Course& course) = 0;
+    virtual void courseUpdated(const Course& course) = 0;
+    virtual void courseCapacityChanged(std::int32_t courseId, std::uint16_t capacity) = 0;
+    virtual void enrollmentAdded(const Enrollment& enrollment) = 0;
+    virtual void enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status) = 0;
+    virtual void waitlistAdded(std::int32_t courseId, std::int32_t studentId) = 0;
+    virtual void waitlistPopped(std::int32_t courseId) = 0;
+    virtual void waitlistRemoved(std::int32_t courseId, std::int32_t studentId) = 0;
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BitOps.h"
+
+// Slab-backed storage for registry entities.
+//
+// Objects are constructed in place inside fixed-size slabs, so creating one
+// costs no heap allocation once a slab is available, neighbours share cache
+// lines, and addresses never move. Each object is identified by a Handle
+// (slab * SlabSize + slot) that stays valid until the object is destroyed;
+// freed slots are reused. Destroying the pool releases one allocation per
+// slab, and skips per-object destructors entirely for trivially
+// destructible types.
+//
+// get() may run concurrently with create()/destroy() of other objects:
+// slabs are found through a directory of doubling segments that never
+// moves. All other members need external synchronization.
+template <typename T, std::size_t SlabSize = 1024>
+class ObjectPool final {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle kInvalidHandle = UINT32_MAX;
+
+    ObjectPool() = default;
+    ~ObjectPool() { clear(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    Handle create(Args&&... args) {
+        Handle handle;
+        if (!m_free.empty()) {
+            handle = m_free.back();
+            m_free.pop_back();
+        } else {
+            handle = static_cast<Handle>(m_live.size());
+            if (handle % SlabSize == 0) {
+                addSlab(handle / SlabSize);
+            }
+            m_live.push_back(false);
+        }
+
+        try {
+            ::new (static_cast<void*>(slot(handle))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            m_free.push_back(handle);
+            throw;
+        }
+        m_live[handle] = true;
+        ++m_size;
+        return handle;
+    }
+
+    void destroy(Handle handle) noexcept {
+        if (handle >= m_live.size() || !m_live[handle]) return;
+        get(handle)->~T();
+        m_live[handle] = false;
+        m_free.push_back(handle);
+        --m_size;
+    }
+
+    T* get(Handle handle) const noexcept {
+        return std::launder(reinterpret_cast<T*>(slot(handle)));
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    void reserve(std::size_t count) {
+        m_live.reserve(count);
+    }
+
+    // Visits live objects in slot order, which walks each slab front to back.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (Handle handle = 0; handle < m_live.size(); ++handle) {
+            if (m_live[handle]) fn(*get(handle));
+        }
+    }
+
+    // Destroys every object and releases all slabs.
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (Handle handle = 0; handle < m_live.size(); ++handle) {
+                if (m_live[handle]) get(handle)->~T();
+            }
+        }
+        const std::size_t slabs = (m_live.size() + SlabSize - 1) / SlabSize;
+        for (std::size_t index = 0; index < slabs; ++index) {
+            delete[] slabAt(index);
+        }
+        for (auto& segment : m_segments) {
+            delete[] segment.exchange(nullptr, std::memory_order_relaxed);
+        }
+        m_live.clear();
+        m_free.clear();
+        m_size = 0;
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // Segment k holds 2^k slab pointers, covering slab indices [2^k - 1, 2^(k+1) - 1).
+    static constexpr std::size_t kSegments = 32;
+
+    static std::size_t segmentOf(std::size_t slab, std::size_t& offset) noexcept {
+        const std::size_t n = slab + 1;
+        const std::size_t segment = highestBit(n);
+        offset = n - (std::size_t{1} << segment);
+        return segment;
+    }
+
+    Slot* slabAt(std::size_t slab) const noexcept {
+        std::size_t offset;
+        const std::size_t segment = segmentOf(slab, offset);
+        return m_segments[segment].load(std::memory_order_acquire)[offset].load(std::memory_order_acquire);
+    }
+
+    void addSlab(std::size_t slab) {
+        std::size_t offset;
+        const std::size_t segment = segmentOf(slab, offset);
+        std::atomic<Slot*>* slabs = m_segments[segment].load(std::memory_order_relaxed);
+        if (!slabs) {
+            const std::size_t length = std::size_t{1} << segment;
+            slabs = new std::atomic<Slot*>[length];
+            for (std::size_t i = 0; i < length; ++i) slabs[i].store(nullptr, std::memory_order_relaxed);
+            m_segments[segment].store(slabs, std::memory_order_release);
+        }
+        slabs[offset].store(new Slot[SlabSize], std::memory_order_release);
+    }
+
+    unsigned char* slot(Handle handle) const noexcept {
+        return slabAt(handle / SlabSize)[handle % SlabSize].bytes;
+    }
+
+    std::atomic<std::atomic<Slot*>*> m_segments[kSegments] = {};
+    std::vector<bool> m_live;
+    std::vector<Handle> m_free;
+    std::size_t m_size = 0;
+};
@@ -0,0 +1,83 @@
+#include "PersistentStore.h"
+
+PersistentStore::PersistentStore(StudentRegistry& students,
+                                 CourseRegistry& courses,
+                                 EnrollmentManager& enrollments,
+                                 WaitlistManager& waitlists)
+    : m_students(students), m_courses(courses), m_enrollments(enrollments), m_waitlists(waitlists) {}
+
+PersistentStore::~PersistentStore() {
+    close();
+}
+
+bool PersistentStore::open(const std::string& basePath, WriteAheadLog::Options options) {
+    close();
+    m_snapshotPath = basePath + ".snap";
+    const std::string logPath = basePath + ".wal";
+
+    std::uint64_t snapshotSequence = 0;
+    auto status = Snapshot::load(m_snapshotPath, m_students, m_courses, m_enrollments, m_waitlists, &snapshotSequence);
+    if (status != Snapshot::Status::Ok && status != Snapshot::Status::NotFound) {
+        m_lastError = m_snapshotPath + ": " + Snapshot::describe(status);
+        return false;
+    }
+    m_restored = status == Snapshot::Status::Ok;
+
+    auto replayed = WriteAheadLog::replay(logPath, snapshotSequence,
+                                          m_students, m_courses, m_enrollments, m_waitlists);
+    if (!replayed.ok) {
+        m_lastError = logPath + ": not a valid log file, or holds a record that cannot be applied";
+        return false;
+    }
+    m_restored = m_restored || replayed.applied > 0;
+
+    if (!m_log.open(logPath, replayed, options)) {
+        m_lastError = logPath + ": cannot open for writing";
+        return false;
+    }
+
+    attach(&m_log);
+    m_open = true;
+    return true;
+}
+
+bool PersistentStore::checkpoint() {
+    if (!m_open) {
+        return false;
+    }
+    if (!m_log.sync()) {
+        m_lastError = "write-ahead log is not writable";
+        return false;
+    }
+
+    auto status = Snapshot::save(m_snapshotPath, m_students, m_courses, m_enrollments, m_waitlists,
+                                 m_log.lastSequence());
+    if (status != Snapshot::Status::Ok) {
+        m_lastError = m_snapshotPath + ": " + Snapshot::describe(status);
+        return false;
+    }
+
+    // The snapshot now covers every logged record. If we crash before the
+    // reset, replay skips those records by sequence number.
+    if (!m_log.reset()) {
+        m_lastError = "write-ahead log could not be truncated";
+        return false;
+    }
+    return true;
+}
+
+void PersistentStore::close() {
+    if (!m_open) {
+        return;
+    }
+    attach(nullptr);
+    m_log.close();
+    m_open = false;
+}
+
+void PersistentStore::attach(MutationLog* log) {
+    m_students.setMutationLog(log);
+    m_courses.setMutationLog(log);
+    m_enrollments.setMutationLog(log);
+    m_waitlists.setMutationLog(log);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include "Snapshot.h"
+#include "WriteAheadLog.h"
+
+// Ties snapshots and the write-ahead log together for one set of registries.
+//
+// open() restores "<base>.snap", replays the mutations in "<base>.wal" that
+// the snapshot does not already contain, and then attaches the log to the
+// registries and managers so every later mutation is recorded. checkpoint()
+// writes a fresh snapshot and empties the log. Callers keep using the
+// registries and managers exactly as before.
+class PersistentStore final {
+public:
+    PersistentStore(StudentRegistry& students,
+                    CourseRegistry& courses,
+                    EnrollmentManager& enrollments,
+                    WaitlistManager& waitlists);
+    ~PersistentStore();
+
+    PersistentStore(const PersistentStore&) = delete;
+    PersistentStore& operator=(const PersistentStore&) = delete;
+
+    // Returns false (see lastError()) if existing data could not be read or
+    // the log could not be opened; nothing is attached in that case.
+    bool open(const std::string& basePath, WriteAheadLog::Options options = WriteAheadLog::Options{});
+
+    // True if open() found a snapshot or any log records.
+    bool restoredData() const noexcept { return m_restored; }
+
+    // Saves a snapshot including everything logged so far, then truncates the log.
+    bool checkpoint();
+
+    // Detaches the log from the registries and flushes it.
+    void close();
+
+    const std::string& lastError() const noexcept { return m_lastError; }
+
+private:
+    void attach(MutationLog* log);
+
+    StudentRegistry& m_students;
+    CourseRegistry& m_courses;
+    EnrollmentManager& m_enrollments;
+    WaitlistManager& m_waitlists;
+
+    WriteAheadLog m_log;
+    std::string m_snapshotPath;
+    bool m_open = false;
+    bool m_restored = false;
+    std::string m_lastError;
+};
@@ -0,0 +1,64 @@
+#include "PrefixIndex.h"
+
+namespace {
+
+inline bool isWordByte(unsigned char c) noexcept {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+inline char lower(unsigned char c) noexcept {
+    return static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+}
+
+} // namespace
+
+void PrefixIndex::insert(std::string_view text, std::uint32_t value) {
+    for (std::string& word : words(text)) {
+        m_entries.emplace(std::move(word), value);
+    }
+}
+
+void PrefixIndex::erase(std::string_view text, std::uint32_t value) {
+    for (std::string& word : words(text)) {
+        m_entries.erase({std::move(word), value});
+    }
+}
+
+std::vector<std::string> PrefixIndex::words(std::string_view text) {
+    std::vector<std::string> result;
+    std::size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && !isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        if (i == text.size()) break;
+        std::string word;
+        while (i < text.size() && isWordByte(static_cast<unsigned char>(text[i]))) {
+            word.push_back(lower(static_cast<unsigned char>(text[i++])));
+        }
+        result.push_back(std::move(word));
+    }
+    return result;
+}
+
+std::string PrefixIndex::normalizeKey(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    std::string key;
+    key.reserve(text.size());
+    for (char c : text) {
+        key.push_back(lower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+bool PrefixIndex::matchesAll(const std::vector<std::string>& queryWords, const std::vector<std::string>& textWords) {
+    for (std::size_t q = 1; q < queryWords.size(); ++q) {
+        const std::string& prefix = queryWords[q];
+        const bool found = std::any_of(textWords.begin(), textWords.end(), [&](const std::string& word) {
+            return word.compare(0, prefix.size(), prefix) == 0;
+        });
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
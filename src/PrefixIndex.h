@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Case-insensitive word-prefix index from free text (names, titles) to
+// 32-bit values, typically pool handles.
+//
+// Text is split into words on anything that is not a letter or digit, and
+// words are lowercased (ASCII; other bytes are kept as they are). Every
+// (word, value) pair is one entry of an ordered set, so all words starting
+// with a prefix are one contiguous range: a search costs O(log n) plus the
+// matches it visits, whatever the index size.
+//
+// Not synchronized; the owner guards it.
+class PrefixIndex {
+public:
+    void insert(std::string_view text, std::uint32_t value);
+    void erase(std::string_view text, std::uint32_t value);
+    void clear() noexcept { m_entries.clear(); }
+
+    // Values whose text has, for every word of `query`, a word starting
+    // with it, e.g. "jo sm" finds "John Smith" and "Smith, Joanna". At most
+    // `limit` values, each once, in the order of their word matching the
+    // longest query word. `textOf(value)` returns a value's current text;
+    // it is only consulted for multi-word queries.
+    template <typename TextOf>
+    std::vector<std::uint32_t> search(std::string_view query, std::size_t limit, TextOf&& textOf) const {
+        std::vector<std::string> queryWords = words(query);
+        std::vector<std::uint32_t> result;
+        if (queryWords.empty() || limit == 0) {
+            return result;
+        }
+        // Drive the scan with the longest word: usually the narrowest range.
+        std::swap(queryWords.front(), *std::max_element(queryWords.begin(), queryWords.end(),
+            [](const std::string& a, const std::string& b) { return a.size() < b.size(); }));
+        const std::string& driver = queryWords.front();
+
+        std::unordered_set<std::uint32_t> seen;
+        std::vector<std::string> candidateWords;
+        for (auto it = m_entries.lower_bound({driver, 0});
+             it != m_entries.end() && it->first.compare(0, driver.size(), driver) == 0; ++it) {
+            const std::uint32_t value = it->second;
+            if (!seen.insert(value).second) continue;
+            if (queryWords.size() > 1) {
+                candidateWords = words(textOf(value));
+                if (!matchesAll(queryWords, candidateWords)) continue;
+            }
+            result.push_back(value);
+            if (result.size() == limit) break;
+        }
+        return result;
+    }
+
+    std::size_t entryCount() const noexcept { return m_entries.size(); }
+
+    // Lowercased words of `text`, as indexed.
+    static std::vector<std::string> words(std::string_view text);
+    // Lowercased `text` without surrounding whitespace; for exact-match keys
+    // such as emails.
+    static std::string normalizeKey(std::string_view text);
+
+private:
+    // True if every query word after the first prefixes some word of `text`.
+    static bool matchesAll(const std::vector<std::string>& queryWords, const std::vector<std::string>& textWords);
+
+    std::set<std::pair<std::string, std::uint32_t>> m_entries;   // (word, value)
+};
@@ -0,0 +1,264 @@
+#include "PrerequisiteGraph.h"
+
+void PrerequisiteGraph::Closure::set(std::uint32_t index) {
+    const std::uint32_t word = index / 64;
+    const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+    const auto it = lowerBound(word);
+    if (it != m_words.end() && it->first == word) {
+        m_words[static_cast<std::size_t>(it - m_words.begin())].second |= bit;
+    } else {
+        m_words.insert(it, {word, bit});
+    }
+}
+
+void PrerequisiteGraph::Closure::unite(const Closure& other) {
+    if (other.m_words.empty()) {
+        return;
+    }
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> merged;
+    merged.reserve(m_words.size() + other.m_words.size());
+    auto a = m_words.begin();
+    auto b = other.m_words.begin();
+    while (a != m_words.end() || b != other.m_words.end()) {
+        if (b == other.m_words.end() || (a != m_words.end() && a->first < b->first)) {
+            merged.push_back(*a++);
+        } else if (a == m_words.end() || b->first < a->first) {
+            merged.push_back(*b++);
+        } else {
+            merged.emplace_back(a->first, a->second | b->second);
+            ++a;
+            ++b;
+        }
+    }
+    m_words = std::move(merged);
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::check(std::int32_t courseId,
+                                                   const std::vector<std::int32_t>& prerequisites) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return checkLocked(courseId, prerequisites, false);
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::checkLocked(std::int32_t courseId,
+                                                         const std::vector<std::int32_t>& prerequisites,
+                                                         bool placeholders) const {
+    const auto course = m_ids.find(courseId);
+    for (std::int32_t prerequisiteId : prerequisites) {
+        if (prerequisiteId == courseId) {
+            return Result::Cycle;
+        }
+        const auto it = m_ids.find(prerequisiteId);
+        if (it == m_ids.end() || !m_nodes[it->second].live) {
+            if (!placeholders) {
+                return Result::UnknownPrerequisite;
+            }
+            continue;   // a placeholder has no prerequisites, so it cannot close a cycle
+        }
+        if (course != m_ids.end() && m_nodes[it->second].closure.test(course->second)) {
+            return Result::Cycle;
+        }
+    }
+    return Result::Ok;
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::addCourse(std::int32_t courseId,
+                                                       const std::vector<std::int32_t>& prerequisites) {
+    return add(courseId, prerequisites, false);
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::restoreCourse(std::int32_t courseId,
+                                                           const std::vector<std::int32_t>& prerequisites) {
+    return add(courseId, prerequisites, true);
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::add(std::int32_t courseId,
+                                                 const std::vector<std::int32_t>& prerequisites,
+                                                 bool placeholders) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    if (it != m_ids.end() && m_nodes[it->second].live) {
+        return Result::DuplicateCourse;
+    }
+    const Result result = checkLocked(courseId, prerequisites, placeholders);
+    if (result != Result::Ok) {
+        return result;
+    }
+    const std::uint32_t index = nodeFor(courseId);
+    m_nodes[index].live = true;
+    ++m_liveCount;
+    replaceEdges(index, prerequisites);
+    recompute(index);
+    return Result::Ok;
+}
+
+PrerequisiteGraph::Result PrerequisiteGraph::setPrerequisites(std::int32_t courseId,
+                                                              const std::vector<std::int32_t>& prerequisites) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    if (it == m_ids.end() || !m_nodes[it->second].live) {
+        return Result::CourseNotFound;
+    }
+    const Result result = checkLocked(courseId, prerequisites, false);
+    if (result != Result::Ok) {
+        return result;
+    }
+    replaceEdges(it->second, prerequisites);
+    recompute(it->second);
+    return Result::Ok;
+}
+
+bool PrerequisiteGraph::removeCourse(std::int32_t courseId) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    if (it == m_ids.end() || !m_nodes[it->second].live) {
+        return false;
+    }
+    m_nodes[it->second].live = false;
+    --m_liveCount;
+    replaceEdges(it->second, {});
+    recompute(it->second);
+    return true;
+}
+
+bool PrerequisiteGraph::contains(std::int32_t courseId) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    return it != m_ids.end() && m_nodes[it->second].live;
+}
+
+bool PrerequisiteGraph::dependsOn(std::int32_t courseId, std::int32_t prerequisiteId) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const auto course = m_ids.find(courseId);
+    const auto prerequisite = m_ids.find(prerequisiteId);
+    return course != m_ids.end() && prerequisite != m_ids.end() &&
+           m_nodes[course->second].closure.test(prerequisite->second);
+}
+
+std::size_t PrerequisiteGraph::level(std::int32_t courseId) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    return it == m_ids.end() ? 0 : m_nodes[it->second].level;
+}
+
+std::vector<std::int32_t> PrerequisiteGraph::transitivePrerequisites(std::int32_t courseId) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(courseId);
+    if (it == m_ids.end()) {
+        return {};
+    }
+    std::vector<std::uint32_t> indices;
+    m_nodes[it->second].closure.forEach([&](std::uint32_t index) { indices.push_back(index); });
+    sortByLevel(indices);
+
+    std::vector<std::int32_t> result;
+    result.reserve(indices.size());
+    for (std::uint32_t index : indices) {
+        result.push_back(m_nodes[index].id);
+    }
+    return result;
+}
+
+std::vector<std::int32_t> PrerequisiteGraph::topologicalOrder() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::vector<std::uint32_t> indices;
+    indices.reserve(m_liveCount);
+    for (std::uint32_t index = 0; index < m_nodes.size(); ++index) {
+        if (m_nodes[index].live) {
+            indices.push_back(index);
+        }
+    }
+    sortByLevel(indices);
+
+    std::vector<std::int32_t> result;
+    result.reserve(indices.size());
+    for (std::uint32_t index : indices) {
+        result.push_back(m_nodes[index].id);
+    }
+    return result;
+}
+
+std::uint32_t PrerequisiteGraph::nodeFor(std::int32_t courseId) {
+    const auto [it, inserted] = m_ids.try_emplace(courseId, static_cast<std::uint32_t>(m_nodes.size()));
+    if (inserted) {
+        m_nodes.emplace_back();
+        m_nodes.back().id = courseId;
+    }
+    return it->second;
+}
+
+void PrerequisiteGraph::replaceEdges(std::uint32_t index, const std::vector<std::int32_t>& prerequisites) {
+    for (std::uint32_t old : m_nodes[index].prerequisites) {
+        auto& dependents = m_nodes[old].dependents;
+        dependents.erase(std::find(dependents.begin(), dependents.end(), index));
+    }
+    std::vector<std::uint32_t> edges;
+    edges.reserve(prerequisites.size());
+    for (std::int32_t prerequisiteId : prerequisites) {
+        const std::uint32_t target = nodeFor(prerequisiteId);
+        if (std::find(edges.begin(), edges.end(), target) == edges.end()) {
+            edges.push_back(target);
+            m_nodes[target].dependents.push_back(index);
+        }
+    }
+    m_nodes[index].prerequisites = std::move(edges);
+}
+
+// Recomputes `changed` and everything that depends on it, each node after
+// all of its prerequisites (Kahn's algorithm over the affected subgraph).
+void PrerequisiteGraph::recompute(std::uint32_t changed) {
+    std::vector<std::uint32_t> affected{changed};
+    std::unordered_map<std::uint32_t, std::uint32_t> pending{{changed, 0}};   // affected prerequisites not yet done
+    for (std::size_t i = 0; i < affected.size(); ++i) {
+        for (std::uint32_t dependent : m_nodes[affected[i]].dependents) {
+            if (pending.emplace(dependent, 0).second) {
+                affected.push_back(dependent);
+            }
+        }
+    }
+    for (std::uint32_t index : affected) {
+        for (std::uint32_t prerequisite : m_nodes[index].prerequisites) {
+            if (pending.count(prerequisite) != 0) {
+                ++pending[index];
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> ready{changed};
+    while (!ready.empty()) {
+        const std::uint32_t index = ready.back();
+        ready.pop_back();
+        Node& node = m_nodes[index];
+        node.closure.clear();
+        node.level = 0;
+        for (std::uint32_t prerequisite : node.prerequisites) {
+            const Node& source = m_nodes[prerequisite];
+            node.closure.unite(source.closure);
+            node.closure.set(prerequisite);
+            node.level = std::max(node.level, source.level + 1);
+        }
+        for (std::uint32_t dependent : node.dependents) {
+            if (--pending[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+}
+
+void PrerequisiteGraph::sortByLevel(std::vector<std::uint32_t>& indices) const {
+    std::sort(indices.begin(), indices.end(), [&](std::uint32_t a, std::uint32_t b) {
+        const Node& x = m_nodes[a];
+        const Node& y = m_nodes[b];
+        return x.level != y.level ? x.level < y.level : x.id < y.id;
+    });
+}
+
+PrerequisiteGraph::Chain PrerequisiteGraph::chainFrom(std::vector<std::uint32_t> found) const {
+    sortByLevel(found);
+    Chain chain;
+    chain.missing.reserve(found.size());
+    for (std::uint32_t index : found) {
+        chain.missing.push_back(m_nodes[index].id);
+        chain.reachable = chain.reachable && m_nodes[index].live;
+    }
+    return chain;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "BitOps.h"
+
+// Prerequisite DAG over the course catalog, kept in sync by CourseRegistry.
+//
+// Every course is a node holding its direct prerequisites, a level (0 with
+// no prerequisites, otherwise one more than its highest prerequisite) and
+// the closure of all its transitive prerequisites as a sparse bitset over
+// node indices. Ordering by level is a topological order, and "does X
+// require Y" is one bit test, which is also how a new edge is checked for a
+// cycle: X -> P closes a cycle iff P is X or P's closure contains X.
+//
+// Edges are validated as they are added, so the graph is always acyclic and
+// every prerequisite names a course that existed at the time. Changes are
+// incremental: adding a course computes one node; changing or removing one
+// recomputes it and the courses that depend on it, in topological order.
+//
+// A removed course stays behind as a placeholder node without prerequisites
+// of its own, so courses that still list it keep it in their closure and
+// report it as unobtainable. restoreCourse() creates placeholders for
+// prerequisites that are not known yet (loading in any order); adding the
+// course later fills the placeholder in.
+//
+// Thread-safe: queries take a shared lock, changes an exclusive one.
+class PrerequisiteGraph {
+public:
+    enum class Result {
+        Ok,
+        CourseNotFound,
+        DuplicateCourse,
+        UnknownPrerequisite,
+        Cycle
+    };
+
+    // Prerequisites a student still lacks for a course.
+    struct Chain {
+        std::vector<std::int32_t> missing;   // every missing course, in an order they can be taken
+        bool reachable = true;               // false if `missing` includes a removed course
+    };
+
+    // Whether `prerequisites` would be accepted as the list of `courseId`
+    // (new or existing). Ok, UnknownPrerequisite or Cycle.
+    Result check(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites) const;
+
+    Result addCourse(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites);
+    // Like addCourse, but unknown prerequisites become placeholders rather
+    // than an error. For loading persisted catalogs.
+    Result restoreCourse(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites);
+    Result setPrerequisites(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites);
+    bool removeCourse(std::int32_t courseId);
+
+    bool contains(std::int32_t courseId) const;
+    // True if `prerequisiteId` is a direct or transitive prerequisite of `courseId`.
+    bool dependsOn(std::int32_t courseId, std::int32_t prerequisiteId) const;
+    // Length of the longest prerequisite chain below the course (0 if none).
+    std::size_t level(std::int32_t courseId) const;
+    // Every direct and transitive prerequisite, lowest level first.
+    std::vector<std::int32_t> transitivePrerequisites(std::int32_t courseId) const;
+    // Every course in the catalog, each after all of its prerequisites.
+    std::vector<std::int32_t> topologicalOrder() const;
+
+    // Walks the prerequisites of `courseId` that `isCompleted(id)` rejects,
+    // without descending below completed courses: their own prerequisites
+    // are taken as satisfied.
+    template <typename Fn>
+    Chain missingChain(std::int32_t courseId, Fn&& isCompleted) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        std::vector<std::uint32_t> found;
+        const auto it = m_ids.find(courseId);
+        if (it == m_ids.end()) {
+            return {};
+        }
+        std::vector<std::uint32_t> stack = m_nodes[it->second].prerequisites;
+        Closure seen;
+        for (std::uint32_t index : stack) seen.set(index);
+        while (!stack.empty()) {
+            const std::uint32_t index = stack.back();
+            stack.pop_back();
+            if (isCompleted(m_nodes[index].id)) continue;
+            found.push_back(index);
+            for (std::uint32_t prerequisite : m_nodes[index].prerequisites) {
+                if (!seen.test(prerequisite)) {
+                    seen.set(prerequisite);
+                    stack.push_back(prerequisite);
+                }
+            }
+        }
+        return chainFrom(std::move(found));
+    }
+
+private:
+    // Sparse bitset: sorted (word index, word) pairs, so a closure costs
+    // memory in proportion to its size rather than the catalog's.
+    class Closure {
+    public:
+        bool test(std::uint32_t index) const noexcept {
+            const auto it = lowerBound(index / 64);
+            return it != m_words.end() && it->first == index / 64 && (it->second >> (index % 64)) & 1u;
+        }
+        void set(std::uint32_t index);
+        void unite(const Closure& other);
+        void clear() noexcept { m_words.clear(); }
+
+        template <typename Fn>
+        void forEach(Fn&& fn) const {
+            for (const auto& [word, bits] : m_words) {
+                for (std::uint64_t rest = bits; rest != 0; rest &= rest - 1) {
+                    fn(word * 64 + lowestBit(rest));
+                }
+            }
+        }
+
+    private:
+        std::vector<std::pair<std::uint32_t, std::uint64_t>>::const_iterator lowerBound(std::uint32_t word) const noexcept {
+            return std::lower_bound(m_words.begin(), m_words.end(), word,
+                                    [](const auto& entry, std::uint32_t w) { return entry.first < w; });
+        }
+
+        std::vector<std::pair<std::uint32_t, std::uint64_t>> m_words;
+    };
+
+    struct Node {
+        std::int32_t id = 0;
+        bool live = false;                           // false for removed courses and placeholders
+        std::uint32_t level = 0;
+        std::vector<std::uint32_t> prerequisites;    // direct, as node indices, no duplicates
+        std::vector<std::uint32_t> dependents;       // nodes listing this one directly
+        Closure closure;                             // transitive prerequisites
+    };
+
+    Result checkLocked(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites, bool placeholders) const;
+    Result add(std::int32_t courseId, const std::vector<std::int32_t>& prerequisites, bool placeholders);
+    std::uint32_t nodeFor(std::int32_t courseId);
+    void replaceEdges(std::uint32_t index, const std::vector<std::int32_t>& prerequisites);
+    void recompute(std::uint32_t changed);
+    void sortByLevel(std::vector<std::uint32_t>& indices) const;
+    Chain chainFrom(std::vector<std::uint32_t> found) const;
+
+    std::vector<Node> m_nodes;                            // indices are never reused
+    std::unordered_map<std::int32_t, std::uint32_t> m_ids;   // course id -> node index
+    std::size_t m_liveCount = 0;
+    mutable std::shared_mutex m_mutex;
+};
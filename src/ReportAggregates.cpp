@@ -0,0 +1,80 @@
+#include "ReportAggregates.h"
+
+void ReportAggregates::enrollmentAdded(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status,
+                                       unsigned credits) {
+    const auto index = static_cast<std::size_t>(status);
+    {
+        Stripe& stripe = stripeFor(courseId);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        ++stripe.courses[courseId].byStatus[index];
+    }
+    if (status == Enrollment::Status::Active) {
+        addCredits(studentId, credits, true);
+    }
+    m_total.fetch_add(1, std::memory_order_relaxed);
+    m_totalByStatus[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReportAggregates::enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId,
+                                               Enrollment::Status from, Enrollment::Status to, unsigned credits) {
+    if (from == to) {
+        return;
+    }
+    const auto fromIndex = static_cast<std::size_t>(from);
+    const auto toIndex = static_cast<std::size_t>(to);
+    {
+        Stripe& stripe = stripeFor(courseId);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        CourseTotals& totals = stripe.courses[courseId];
+        --totals.byStatus[fromIndex];
+        ++totals.byStatus[toIndex];
+    }
+    if (from == Enrollment::Status::Active || to == Enrollment::Status::Active) {
+        addCredits(studentId, credits, to == Enrollment::Status::Active);
+    }
+    m_totalByStatus[fromIndex].fetch_sub(1, std::memory_order_relaxed);
+    m_totalByStatus[toIndex].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReportAggregates::waitlistChanged(std::int32_t courseId, std::ptrdiff_t delta) {
+    Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    std::size_t& waitlisted = stripe.courses[courseId].waitlisted;
+    waitlisted = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(waitlisted) + delta);
+}
+
+ReportAggregates::CourseTotals ReportAggregates::courseTotals(std::int32_t courseId) const {
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.courses.find(courseId);
+    return it == stripe.courses.end() ? CourseTotals{} : it->second;
+}
+
+unsigned ReportAggregates::creditLoad(std::int32_t studentId) const {
+    const Stripe& stripe = stripeFor(studentId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.creditLoads.find(studentId);
+    return it == stripe.creditLoads.end() ? 0 : it->second;
+}
+
+void ReportAggregates::clear() {
+    for (Stripe& stripe : m_stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        stripe.courses.clear();
+        stripe.creditLoads.clear();
+    }
+    m_total.store(0, std::memory_order_relaxed);
+    for (auto& count : m_totalByStatus) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ReportAggregates::addCredits(std::int32_t studentId, unsigned credits, bool add) {
+    Stripe& stripe = stripeFor(studentId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    unsigned& load = stripe.creditLoads[studentId];
+    load = add ? load + credits : load - credits;
+    if (load == 0) {
+        stripe.creditLoads.erase(studentId);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "Enrollment.h"
+#include "EnrollmentTable.h"
+
+// Running totals behind the reports: enrollments per course per status,
+// waitlist depth per course, active credit load per student, and overall
+// counts. EnrollmentManager and WaitlistManager update them in O(1) as they
+// mutate, so a report reads precomputed numbers instead of scanning
+// enrollments.
+//
+// Attach one with setAggregates() on both managers before any data is
+// loaded; mutations made while detached are not counted. Thread-safe:
+// per-course and per-student totals are spread over lock stripes keyed by
+// id, like WaitlistManager's waitlists, and the overall counts are atomics.
+class ReportAggregates {
+public:
+    static constexpr std::size_t kStatusCount = EnrollmentTable::kStatusCount;
+
+    struct CourseTotals {
+        std::array<std::size_t, kStatusCount> byStatus{};   // indexed by Enrollment::Status
+        std::size_t waitlisted = 0;
+
+        std::size_t count(Enrollment::Status status) const noexcept {
+            return byStatus[static_cast<std::size_t>(status)];
+        }
+    };
+
+    // Updates, called by the managers. `credits` is what the enrollment
+    // adds to (or, leaving Active, removes from) the student's load.
+    void enrollmentAdded(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status, unsigned credits);
+    void enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId, Enrollment::Status from,
+                                 Enrollment::Status to, unsigned credits);
+    void waitlistChanged(std::int32_t courseId, std::ptrdiff_t delta);
+
+    // Totals for one course; all zero for a course never seen.
+    CourseTotals courseTotals(std::int32_t courseId) const;
+    // Credits of the student's active enrollments.
+    unsigned creditLoad(std::int32_t studentId) const;
+    std::size_t totalEnrollments() const noexcept { return m_total.load(std::memory_order_relaxed); }
+    std::size_t totalWithStatus(Enrollment::Status status) const noexcept {
+        return m_totalByStatus[static_cast<std::size_t>(status)].load(std::memory_order_relaxed);
+    }
+
+    // Calls fn(courseId, const CourseTotals&) for every course seen so far,
+    // holding each stripe's lock while its courses are visited.
+    template <typename Fn>
+    void forEachCourse(Fn&& fn) const {
+        for (const Stripe& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            for (const auto& [courseId, totals] : stripe.courses) {
+                fn(courseId, totals);
+            }
+        }
+    }
+
+    void clear();
+
+private:
+    static constexpr std::size_t kStripes = 64;
+
+    struct alignas(64) Stripe {
+        mutable std::mutex mutex;
+        std::unordered_map<std::int32_t, CourseTotals> courses;
+        std::unordered_map<std::int32_t, unsigned> creditLoads;   // studentId -> active credits
+    };
+
+    Stripe& stripeFor(std::int32_t id) noexcept {
+        return m_stripes[static_cast<std::uint32_t>(id) % kStripes];
+    }
+    const Stripe& stripeFor(std::int32_t id) const noexcept {
+        return m_stripes[static_cast<std::uint32_t>(id) % kStripes];
+    }
+    void addCredits(std::int32_t studentId, unsigned credits, bool add);
+
+    std::array<Stripe, kStripes> m_stripes;
+    std::atomic<std::size_t> m_total{0};
+    std::array<std::atomic<std::size_t>, kStatusCount> m_totalByStatus{};
+};
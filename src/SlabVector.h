@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Sequence stored in fixed-size chunks that are allocated on first use and
+// never move. Elements are contiguous within a chunk, so a scan walks long
+// runs instead of chasing one heap pointer per element, and references
+// stay valid while the sequence grows. A chunk is installed with a single
+// compare-and-swap, so threads may grow the sequence concurrently; access
+// to the elements themselves is up to the caller. Elements start
+// value-initialized (zero for integers and atomics).
+template <typename T, std::size_t ChunkSize, std::size_t MaxChunks>
+class SlabVector final {
+public:
+    static constexpr std::size_t kCapacity = ChunkSize * MaxChunks;
+
+    SlabVector() : m_chunks(new std::atomic<T*>[MaxChunks]()) {}
+    ~SlabVector() {
+        for (std::size_t i = 0; i < MaxChunks; ++i) {
+            delete[] m_chunks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    SlabVector(const SlabVector&) = delete;
+    SlabVector& operator=(const SlabVector&) = delete;
+
+    // Element `index` (< kCapacity), allocating its chunk if needed.
+    T& grow(std::size_t index) { return chunkFor(index / ChunkSize)[index % ChunkSize]; }
+
+    // Element `index`, whose chunk must already exist.
+    T& operator[](std::size_t index) noexcept {
+        return m_chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+    }
+    const T& operator[](std::size_t index) const noexcept {
+        return m_chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+    }
+
+    // The ChunkSize elements of chunk `chunk`, or nullptr while it has not
+    // been allocated.
+    const T* chunk(std::size_t chunk) const noexcept { return m_chunks[chunk].load(std::memory_order_acquire); }
+
+    // Allocates the chunks holding the first `count` elements.
+    void reserve(std::size_t count) {
+        for (std::size_t chunk = 0; chunk * ChunkSize < count; ++chunk) {
+            chunkFor(chunk);
+        }
+    }
+
+private:
+    T* chunkFor(std::size_t chunk) {
+        std::atomic<T*>& slot = m_chunks[chunk];
+        T* elements = slot.load(std::memory_order_acquire);
+        if (!elements) {
+            // Threads that reach a new chunk together each build one; one wins.
+            std::unique_ptr<T[]> fresh(new T[ChunkSize]());
+            if (slot.compare_exchange_strong(elements, fresh.get(), std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                elements = fresh.release();
+            }
+        }
+        return elements;
+    }
+
+    std::unique_ptr<std::atomic<T*>[]> m_chunks;
+};
@@ -0,0 +1,378 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "FileUtil.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'E', 'S', 'N', 'A', 'P', '\0', '\x01'};
+
+struct StringRef {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t fileSize;
+    std::uint64_t studentCount;
+    std::uint64_t courseCount;
+    std::uint64_t prerequisiteCount;
+    std::uint64_t enrollmentCount;
+    std::uint64_t waitlistCount;
+    std::uint64_t waitlistEntryCount;
+    std::uint64_t stringBytes;
+    std::uint64_t logSequence;
+};
+
+struct StudentRecord {
+    std::int32_t id;
+    std::uint32_t reserved;
+    StringRef name;
+    StringRef email;
+    StringRef phone;
+    StringRef address;
+    StringRef password;
+};
+
+struct CourseRecord {
+    std::int32_t id;
+    std::uint8_t credits;
+    std::uint8_t reserved;
+    std::uint16_t capacity;   // Course::kUnlimitedCapacity = no limit, 0 = closed
+    StringRef name;
+    StringRef instructor;
+    std::uint32_t firstPrerequisite;
+    std::uint32_t prerequisiteCount;
+};
+
+struct EnrollmentRecord {
+    std::int32_t studentId;
+    std::int32_t courseId;
+    std::int64_t enrolledAtNs;   // nanoseconds since the system_clock epoch
+    std::uint32_t status;        // Enrollment::Status
+    std::uint32_t reserved;
+};
+
+struct WaitlistRecord {
+    std::int32_t courseId;
+    std::uint32_t entryCount;
+};
+
+static_assert(sizeof(FileHeader) == 88, "snapshot header layout changed");
+static_assert(sizeof(StudentRecord) == 48, "snapshot student layout changed");
+static_assert(sizeof(CourseRecord) == 32, "snapshot course layout changed");
+static_assert(sizeof(EnrollmentRecord) == 24, "snapshot enrollment layout changed");
+static_assert(sizeof(WaitlistRecord) == 8, "snapshot waitlist layout changed");
+
+constexpr std::uint64_t align8(std::uint64_t n) noexcept { return (n + 7) & ~std::uint64_t{7}; }
+
+// Byte offsets of each section, derived purely from the header counts.
+struct Layout {
+    std::uint64_t students, courses, prerequisites, enrollments, waitlists, waitlistEntries, strings, end;
+
+    explicit Layout(const FileHeader& h) {
+        students = align8(sizeof(FileHeader));
+        courses = align8(students + h.studentCount * sizeof(StudentRecord));
+        prerequisites = align8(courses + h.courseCount * sizeof(CourseRecord));
+        enrollments = align8(prerequisites + h.prerequisiteCount * sizeof(std::int32_t));
+        waitlists = align8(enrollments + h.enrollmentCount * sizeof(EnrollmentRecord));
+        waitlistEntries = align8(waitlists + h.waitlistCount * sizeof(WaitlistRecord));
+        strings = align8(waitlistEntries + h.waitlistEntryCount * sizeof(std::int32_t));
+        end = strings + h.stringBytes;
+    }
+};
+
+class StringBlob {
+public:
+    bool add(std::string_view value, StringRef& ref) {
+        if (m_bytes.size() + value.size() > UINT32_MAX) {
+            return false;
+        }
+        ref.offset = static_cast<std::uint32_t>(m_bytes.size());
+        ref.length = static_cast<std::uint32_t>(value.size());
+        m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+        return true;
+    }
+    const std::vector<char>& bytes() const noexcept { return m_bytes; }
+
+private:
+    std::vector<char> m_bytes;
+};
+
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+class SectionWriter {
+public:
+    explicit SectionWriter(std::FILE* file) : m_file(file) {}
+
+    // Pads to `offset` and writes `bytes` there.
+    bool writeAt(std::uint64_t offset, const void* data, std::size_t bytes) {
+        static const char zeros[8] = {};
+        while (m_pos < offset) {
+            const std::size_t pad = static_cast<std::size_t>(std::min<std::uint64_t>(offset - m_pos, sizeof(zeros)));
+            if (std::fwrite(zeros, 1, pad, m_file) != pad) return false;
+            m_pos += pad;
+        }
+        if (bytes > 0 && std::fwrite(data, 1, bytes, m_file) != bytes) {
+            return false;
+        }
+        m_pos += bytes;
+        return true;
+    }
+
+private:
+    std::FILE* m_file;
+    std::uint64_t m_pos = 0;
+};
+
+template <typename T>
+const T* sectionAt(const unsigned char* base, std::uint64_t offset) noexcept {
+    return reinterpret_cast<const T*>(base + offset);
+}
+
+} // namespace
+
+Snapshot::Status Snapshot::save(const std::string& path,
+                                const StudentRegistry& students,
+                                const CourseRegistry& courses,
+                                const EnrollmentManager& enrollments,
+                                const WaitlistManager& waitlists,
+                                std::uint64_t logSequence) {
+    StringBlob strings;
+
+    std::vector<StudentRecord> studentRecords;
+    studentRecords.reserve(students.size());
+    for (const Student* student : students.allStudents()) {
+        StudentRecord record{};
+        record.id = student->id();
+        if (!strings.add(student->name(), record.name) ||
+            !strings.add(student->email(), record.email) ||
+            !strings.add(student->phone(), record.phone) ||
+            !strings.add(student->address(), record.address) ||
+            !strings.add(student->password(), record.password)) {
+            return Status::TooLarge;
+        }
+        studentRecords.push_back(record);
+    }
+
+    std::vector<CourseRecord> courseRecords;
+    std::vector<std::int32_t> prerequisites;
+    courseRecords.reserve(courses.size());
+    for (const Course* course : courses.allCourses()) {
+        CourseRecord record{};
+        record.id = course->id();
+        record.credits = course->credits();
+        record.capacity = course->capacity();
+        record.firstPrerequisite = static_cast<std::uint32_t>(prerequisites.size());
+        record.prerequisiteCount = static_cast<std::uint32_t>(course->prerequisites().size());
+        prerequisites.insert(prerequisites.end(), course->prerequisites().begin(), course->prerequisites().end());
+        if (!strings.add(course->name(), record.name) ||
+            !strings.add(course->instructor(), record.instructor)) {
+            return Status::TooLarge;
+        }
+        courseRecords.push_back(record);
+    }
+
+    std::vector<EnrollmentRecord> enrollmentRecords;
+    enrollments.withTable([&enrollmentRecords](const EnrollmentTable& table) {
+        enrollmentRecords.reserve(table.size());
+        table.forEachBlock([&](const EnrollmentTable::Block& block) {
+            for (std::size_t i = 0; i < block.count; ++i) {
+                EnrollmentRecord record{};
+                record.studentId = block.studentIds[i];
+                record.courseId = block.courseIds[i];
+                record.enrolledAtNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    block.dates[i].time_since_epoch()).count();
+                record.status = static_cast<std::uint8_t>(table.status(block.firstRow + i));
+                enrollmentRecords.push_back(record);
+            }
+        });
+    });
+
+    std::vector<WaitlistRecord> waitlistRecords;
+    std::vector<std::int32_t> waitlistEntries;
+    waitlists.forEachWaitlist([&](std::int32_t courseId, const Waitlist& waitlist) {
+        waitlistRecords.push_back({courseId, static_cast<std::uint32_t>(waitlist.size())});
+        waitlistEntries.insert(waitlistEntries.end(), waitlist.begin(), waitlist.end());
+    });
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.headerSize = sizeof(FileHeader);
+    header.studentCount = studentRecords.size();
+    header.courseCount = courseRecords.size();
+    header.prerequisiteCount = prerequisites.size();
+    header.enrollmentCount = enrollmentRecords.size();
+    header.waitlistCount = waitlistRecords.size();
+    header.waitlistEntryCount = waitlistEntries.size();
+    header.stringBytes = strings.bytes().size();
+    header.logSequence = logSequence;
+    const Layout layout(header);
+    header.fileSize = layout.end;
+
+    const std::string tempPath = path + ".tmp";
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(tempPath.c_str(), "wb"));
+    if (!file) {
+        return Status::IoError;
+    }
+    std::setvbuf(file.get(), nullptr, _IOFBF, 1 << 20);
+
+    SectionWriter writer(file.get());
+    const bool written =
+        writer.writeAt(0, &header, sizeof(header)) &&
+        writer.writeAt(layout.students, studentRecords.data(), studentRecords.size() * sizeof(StudentRecord)) &&
+        writer.writeAt(layout.courses, courseRecords.data(), courseRecords.size() * sizeof(CourseRecord)) &&
+        writer.writeAt(layout.prerequisites, prerequisites.data(), prerequisites.size() * sizeof(std::int32_t)) &&
+        writer.writeAt(layout.enrollments, enrollmentRecords.data(), enrollmentRecords.size() * sizeof(EnrollmentRecord)) &&
+        writer.writeAt(layout.waitlists, waitlistRecords.data(), waitlistRecords.size() * sizeof(WaitlistRecord)) &&
+        writer.writeAt(layout.waitlistEntries, waitlistEntries.data(), waitlistEntries.size() * sizeof(std::int32_t)) &&
+        writer.writeAt(layout.strings, strings.bytes().data(), strings.bytes().size()) &&
+        syncFile(file.get());
+    file.reset();
+
+    if (!written || !replaceFile(tempPath, path)) {
+        std::remove(tempPath.c_str());
+        return Status::IoError;
+    }
+    return Status::Ok;
+}
+
+Snapshot::Status Snapshot::load(const std::string& path,
+                                StudentRegistry& students,
+                                CourseRegistry& courses,
+                                EnrollmentManager& enrollments,
+                                WaitlistManager& waitlists,
+                                std::uint64_t* logSequence) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::error_code ec;
+        return std::filesystem::status(path, ec).type() == std::filesystem::file_type::not_found
+                   ? Status::NotFound
+                   : Status::IoError;
+    }
+
+    const unsigned char* base = file.data();
+    if (file.size() < sizeof(FileHeader)) {
+        return Status::BadFormat;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.headerSize != sizeof(FileHeader)) {
+        return Status::BadFormat;
+    }
+    if (header.version != kFormatVersion) {
+        return Status::VersionMismatch;
+    }
+
+    // Every count is bounded by the file size before any offset arithmetic,
+    // so the layout computation below cannot overflow.
+    const std::uint64_t size = file.size();
+    if (header.fileSize != size ||
+        header.studentCount > size || header.courseCount > size || header.prerequisiteCount > size ||
+        header.enrollmentCount > size || header.waitlistCount > size ||
+        header.waitlistEntryCount > size || header.stringBytes > size) {
+        return Status::BadFormat;
+    }
+    const Layout layout(header);
+    if (layout.end != size) {
+        return Status::BadFormat;
+    }
+
+    const char* blob = sectionAt<char>(base, layout.strings);
+    const auto* studentRecords = sectionAt<StudentRecord>(base, layout.students);
+    const auto* courseRecords = sectionAt<CourseRecord>(base, layout.courses);
+    const auto* prerequisites = sectionAt<std::int32_t>(base, layout.prerequisites);
+    const auto* enrollmentRecords = sectionAt<EnrollmentRecord>(base, layout.enrollments);
+    const auto* waitlistRecords = sectionAt<WaitlistRecord>(base, layout.waitlists);
+    const auto* waitlistEntries = sectionAt<std::int32_t>(base, layout.waitlistEntries);
+
+    // Check every record before inserting any, so a corrupt file leaves the
+    // targets as they were.
+    auto inBlob = [&](const StringRef& ref) { return std::uint64_t{ref.offset} + ref.length <= header.stringBytes; };
+    for (std::uint64_t i = 0; i < header.studentCount; ++i) {
+        const StudentRecord& r = studentRecords[i];
+        if (!inBlob(r.name) || !inBlob(r.email) || !inBlob(r.phone) || !inBlob(r.address) || !inBlob(r.password)) {
+            return Status::BadFormat;
+        }
+    }
+    for (std::uint64_t i = 0; i < header.courseCount; ++i) {
+        const CourseRecord& r = courseRecords[i];
+        if (!inBlob(r.name) || !inBlob(r.instructor) ||
+            std::uint64_t{r.firstPrerequisite} + r.prerequisiteCount > header.prerequisiteCount) {
+            return Status::BadFormat;
+        }
+    }
+    for (std::uint64_t i = 0; i < header.enrollmentCount; ++i) {
+        if (enrollmentRecords[i].status > static_cast<std::uint32_t>(Enrollment::Status::Withdrawn)) {
+            return Status::BadFormat;
+        }
+    }
+    std::uint64_t entries = 0;
+    for (std::uint64_t i = 0; i < header.waitlistCount; ++i) {
+        entries += waitlistRecords[i].entryCount;
+        if (entries > header.waitlistEntryCount) {
+            return Status::BadFormat;
+        }
+    }
+
+    auto text = [blob](const StringRef& ref) { return std::string(blob + ref.offset, ref.length); };
+
+    students.reserve(students.size() + header.studentCount);
+    for (std::uint64_t i = 0; i < header.studentCount; ++i) {
+        const StudentRecord& r = studentRecords[i];
+        students.restoreStudent(r.id, text(r.name), text(r.email), text(r.phone), text(r.address), text(r.password));
+    }
+
+    courses.reserve(courses.size() + header.courseCount);
+    for (std::uint64_t i = 0; i < header.courseCount; ++i) {
+        const CourseRecord& r = courseRecords[i];
+        std::vector<std::int32_t> prereqs(prerequisites + r.firstPrerequisite,
+                                          prerequisites + r.firstPrerequisite + r.prerequisiteCount);
+        courses.restoreCourse(r.id, text(r.name), r.credits, text(r.instructor), std::move(prereqs), r.capacity);
+    }
+
+    enrollments.reserve(enrollments.enrollmentCount() + header.enrollmentCount);
+    for (std::uint64_t i = 0; i < header.enrollmentCount; ++i) {
+        const EnrollmentRecord& r = enrollmentRecords[i];
+        const std::chrono::system_clock::time_point date(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(r.enrolledAtNs)));
+        enrollments.restoreEnrollment(Enrollment(r.studentId, r.courseId,
+                                                 static_cast<Enrollment::Status>(r.status), date));
+    }
+
+    std::uint64_t entry = 0;
+    for (std::uint64_t i = 0; i < header.waitlistCount; ++i) {
+        for (std::uint32_t k = 0; k < waitlistRecords[i].entryCount; ++k) {
+            waitlists.addToWaitlist(waitlistRecords[i].courseId, waitlistEntries[entry++]);
+        }
+    }
+
+    if (logSequence) {
+        *logSequence = header.logSequence;
+    }
+    return Status::Ok;
+}
+
+const char* Snapshot::describe(Status status) noexcept {
+    switch (status) {
+        case Status::Ok: return "ok";
+        case Status::NotFound: return "file not found";
+        case Status::IoError: return "I/O error";
+        case Status::BadFormat: return "not a valid snapshot file";
+        case Status::VersionMismatch: return "unsupported snapshot version";
+        case Status::TooLarge: return "snapshot too large for format";
+    }
+    return "unknown";
+}
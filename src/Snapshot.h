@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+
+// Binary snapshot of the complete system state: students, courses with
+// their prerequisites, enrollments with status and date, and waitlist order.
+//
+// The file is a fixed header followed by flat, 8-byte aligned record arrays
+// and one string blob, so loading is a single mmap, a pass that checks every
+// record, and a pass that copies each record's strings out of the blob into
+// its object. Saving writes to "<path>.tmp",
+// syncs it, and renames it over `path`, so a crash never leaves a torn file.
+// Integers are stored in native (little-endian) byte order.
+class Snapshot final {
+public:
+    enum class Status {
+        Ok,
+        NotFound,         // load only: no file at the path
+        IoError,          // file could not be created, written, opened or mapped
+        BadFormat,        // not a snapshot, or truncated/corrupt
+        VersionMismatch,  // written by an incompatible format version
+        TooLarge          // string data exceeds the 4 GiB the format can address
+    };
+
+    static constexpr std::uint32_t kFormatVersion = 3;
+
+    // `logSequence` records the last write-ahead log record the snapshot
+    // already includes (see WriteAheadLog); pass 0 when no log is in use.
+    static Status save(const std::string& path,
+                       const StudentRegistry& students,
+                       const CourseRegistry& courses,
+                       const EnrollmentManager& enrollments,
+                       const WaitlistManager& waitlists,
+                       std::uint64_t logSequence = 0);
+
+    // Loads into the given objects, which should normally be empty. Entities
+    // whose ids already exist are skipped, matching addStudent/addCourse.
+    // Any status other than Ok means nothing was loaded.
+    static Status load(const std::string& path,
+                       StudentRegistry& students,
+                       CourseRegistry& courses,
+                       EnrollmentManager& enrollments,
+                       WaitlistManager& waitlists,
+                       std::uint64_t* logSequence = nullptr);
+
+    static const char* describe(Status status) noexcept;
+};
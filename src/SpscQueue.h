@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. push() and pop() never block and never allocate: each side owns
+// one index and publishes it with a release store, so the other side sees
+// the slot's contents before it sees the index move.
+//
+// Capacity is rounded up to a power of two; one slot stays empty to tell a
+// full ring from an empty one.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : m_mask(roundUp(capacity + 1) - 1), m_slots(new std::optional<T>[m_mask + 1]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side. Returns false (and leaves `value` untouched) if full.
+    bool push(T&& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t next = (tail + 1) & m_mask;
+        if (next == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        m_slots[tail].emplace(std::move(value));
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Empty optional if there is nothing to take.
+    std::optional<T> pop() {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> value = std::move(m_slots[head]);
+        m_slots[head].reset();
+        m_head.store((head + 1) & m_mask, std::memory_order_release);
+        return value;
+    }
+
+    // Exact only when called from one of the two sides while the other is idle.
+    bool empty() const noexcept {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static std::size_t roundUp(std::size_t n) noexcept {
+        std::size_t size = 2;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    const std::size_t m_mask;
+    std::unique_ptr<std::optional<T>[]> m_slots;
+    alignas(64) std::atomic<std::size_t> m_head{0};   // next slot to pop; written by the consumer
+    alignas(64) std::atomic<std::size_t> m_tail{0};   // next slot to fill; written by the producer
+};
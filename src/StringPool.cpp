@@ -0,0 +1,108 @@
+#include "StringPool.h"
+#include <cstring>
+#include <mutex>
+#include "BitOps.h"
+
+StringPool::StringPool() {
+    intern({});
+}
+
+StringPool::~StringPool() {
+    for (auto& segment : m_segments) {
+        delete[] segment.exchange(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StringPool::Id StringPool::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const auto it = m_ids.find(text);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(text);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    const Id id = m_next;
+    std::size_t offset;
+    const std::size_t segment = segmentOf(id, offset);
+    std::string_view* entries = m_segments[segment].load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = new std::string_view[std::size_t{1} << segment];
+        m_segments[segment].store(entries, std::memory_order_release);
+    }
+    const std::string_view stored = store(text);
+    entries[offset] = stored;
+    m_ids.emplace(stored, id);
+    ++m_next;
+    return id;
+}
+
+bool StringPool::find(std::string_view text, Id& id) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const auto it = m_ids.find(text);
+    if (it == m_ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+std::size_t StringPool::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_next;
+}
+
+std::size_t StringPool::memoryBytes() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::size_t bytes = m_arenaBytes;
+    for (std::size_t segment = 0; segment < kSegments; ++segment) {
+        if (m_segments[segment].load(std::memory_order_relaxed)) {
+            bytes += (std::size_t{1} << segment) * sizeof(std::string_view);
+        }
+    }
+    // Each map node holds the key, the id and a next pointer (plus the cached hash in libstdc++).
+    bytes += m_ids.bucket_count() * sizeof(void*) +
+             m_ids.size() * (sizeof(std::string_view) + sizeof(Id) + 2 * sizeof(void*));
+    return bytes;
+}
+
+StringPool& StringPool::instructors() {
+    static StringPool pool;
+    return pool;
+}
+
+std::size_t StringPool::segmentOf(Id id, std::size_t& offset) noexcept {
+    const std::uint64_t n = std::uint64_t{id} + 1;
+    const std::size_t segment = highestBit(n);
+    offset = static_cast<std::size_t>(n - (std::uint64_t{1} << segment));
+    return segment;
+}
+
+std::string_view StringPool::store(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    if (text.size() > kBlockBytes / 4) {
+        // Long strings get a block of their own, kept ahead of the open block.
+        auto block = std::make_unique<char[]>(text.size());
+        m_arenaBytes += text.size();
+        std::memcpy(block.get(), text.data(), text.size());
+        const std::string_view stored(block.get(), text.size());
+        m_blocks.insert(m_blocks.empty() ? m_blocks.end() : m_blocks.end() - 1, std::move(block));
+        return stored;
+    }
+    if (m_blockUsed + text.size() > kBlockBytes) {
+        m_blocks.push_back(std::make_unique<char[]>(kBlockBytes));
+        m_arenaBytes += kBlockBytes;
+        m_blockUsed = 0;
+    }
+    char* destination = m_blocks.back().get() + m_blockUsed;
+    std::memcpy(destination, text.data(), text.size());
+    m_blockUsed += text.size();
+    return {destination, text.size()};
+}
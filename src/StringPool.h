@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Interned strings. Each distinct string is stored once and named by a
+// small integer id, so fields that repeat a few hundred values across many
+// records (instructors across course sections) cost 4 bytes a record and
+// compare, hash and group as integers.
+//
+// Ids are dense, start at 1, and stay valid for the pool's lifetime; id 0
+// is always the empty string. Interned text is never moved or freed, so a
+// view() stays valid as long as the pool does.
+//
+// view() is lock-free and may run concurrently with intern(); intern() and
+// find() take an internal lock.
+class StringPool final {
+public:
+    using Id = std::uint32_t;
+    static constexpr Id kEmpty = 0;
+
+    StringPool();
+    ~StringPool();
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Id of `text`, adding it if it is new.
+    Id intern(std::string_view text);
+    // Id of `text` if it has been interned; false (and `id` untouched) if not.
+    bool find(std::string_view text, Id& id) const;
+    // Text of an id returned by this pool.
+    std::string_view view(Id id) const noexcept {
+        std::size_t offset;
+        const std::size_t segment = segmentOf(id, offset);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    // Distinct strings held, counting the empty string.
+    std::size_t size() const;
+    // Heap bytes held: text, the id table and the lookup table (the latter
+    // estimated from its bucket and node counts).
+    std::size_t memoryBytes() const;
+
+    // Process-wide pool for course instructor names and their lookup keys.
+    static StringPool& instructors();
+
+private:
+    static constexpr std::size_t kBlockBytes = 64 * 1024;
+
+    // Segment k holds 2^k entries, covering ids [2^k - 1, 2^(k+1) - 1).
+    static constexpr std::size_t kSegments = 33;
+
+    static std::size_t segmentOf(Id id, std::size_t& offset) noexcept;
+    // Copies `text` into the arena and returns a view of the copy.
+    std::string_view store(std::string_view text);
+
+    std::atomic<std::string_view*> m_segments[kSegments] = {};
+    std::vector<std::unique_ptr<char[]>> m_blocks;   // text arena; never reallocated in place
+    std::size_t m_blockUsed = kBlockBytes;           // bytes used in m_blocks.back()
+    std::size_t m_arenaBytes = 0;                    // bytes allocated for m_blocks
+    std::unordered_map<std::string_view, Id> m_ids;  // views into the arena
+    Id m_next = 0;
+    mutable std::shared_mutex m_mutex;               // guards everything but m_segments reads
+};
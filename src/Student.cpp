@@ -1,5 +1,7 @@
 #include "Student.h"
 
+const std::string Student::kEmpty;
+
 Student::Student(std::int32_t id,
                  std::string name,
                  std::string email,
@@ -7,8 +9,31 @@ Student::Student(std::int32_t id,
                  std::string address,
                  std::string password)
     : m_id(id),
-      m_name(std::move(name)),
-      m_email(std::move(email)),
-      m_phone(std::move(phone)),
-      m_address(std::move(address)),
-      m_password(std::move(password)) {} 
\ No newline at end of file
+      m_name(std::move(name)) {
+    if (!email.empty() || !phone.empty() || !address.empty() || !password.empty()) {
+        m_profile = std::make_unique<Profile>(
+            Profile{std::move(email), std::move(phone), std::move(address), std::move(password)});
+    }
+}
+
+Student::Student(const Student& other)
+    : m_id(other.m_id),
+      m_name(other.m_name),
+      m_profile(other.m_profile ? std::make_unique<Profile>(*other.m_profile) : nullptr) {}
+
+Student& Student::operator=(const Student& other) {
+    if (this != &other) {
+        *this = Student(other);
+    }
+    return *this;
+}
+
+void Student::setProfileField(std::string Profile::*field, std::string value) {
+    if (!m_profile) {
+        if (value.empty()) {
+            return;
+        }
+        m_profile = std::make_unique<Profile>();
+    }
+    (*m_profile).*field = std::move(value);
+}
@@ -2,10 +2,18 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
 
 // A lightweight value-object representing a student in the enrollment system.
-// This class is fully RAII and does not allocate any dynamic memory on its own —
-// all std::string members manage their memory automatically.
+//
+// Fields are split by how often they are read. The id and name, which
+// lookups, enrollment checks and listings use, are stored inline, so a
+// StudentRegistry's pool slabs form a compact, contiguous table of them
+// (48 bytes a student instead of 168 with libstdc++). Contact data and
+// credentials live in a separately allocated Profile, created by the
+// constructor or a setter only when one of those fields is non-empty, so
+// hot paths never pull them into cache and students without them carry no
+// second allocation.
 class Student final {
 public:
     Student(std::int32_t id,
@@ -15,24 +23,48 @@ public:
             std::string address = {},
             std::string password = {});
 
+    Student(const Student& other);
+    Student& operator=(const Student& other);
+    Student(Student&&) noexcept = default;
+    Student& operator=(Student&&) noexcept = default;
+
     // ---------- Immutable getters ----------
     std::int32_t id() const noexcept { return m_id; }
     const std::string &name() const noexcept { return m_name; }
-    const std::string &email() const noexcept { return m_email; }
-    const std::string &phone() const noexcept { return m_phone; }
-    const std::string &address() const noexcept { return m_address; }
+    const std::string &email() const noexcept { return m_profile ? m_profile->email : kEmpty; }
+    const std::string &phone() const noexcept { return m_profile ? m_profile->phone : kEmpty; }
+    const std::string &address() const noexcept { return m_profile ? m_profile->address : kEmpty; }
+    // True once any contact or credential field has been set.
+    bool hasProfile() const noexcept { return m_profile != nullptr; }
 
     // ---------- Mutators ----------
+    // For a registered student use StudentRegistry::setName/setEmail, which
+    // keep the registry's name and email indexes in sync.
     void setName(std::string name) { m_name = std::move(name); }
-    void setEmail(std::string email) { m_email = std::move(email); }
-    void setPhone(std::string phone) { m_phone = std::move(phone); }
-    void setAddress(std::string address) { m_address = std::move(address); }
+    void setEmail(std::string email) { setProfileField(&Profile::email, std::move(email)); }
+    void setPhone(std::string phone) { setProfileField(&Profile::phone, std::move(phone)); }
+    void setAddress(std::string address) { setProfileField(&Profile::address, std::move(address)); }
 
 private:
+    // The password is not part of the public interface; only the
+    // persistence code, which has to save it, can read it.
+    friend class Snapshot;
+    friend class WriteAheadLog;
+    const std::string &password() const noexcept { return m_profile ? m_profile->password : kEmpty; }
+
+    // Cold fields, read only when a student's details are shown or saved
+    struct Profile {
+        std::string email;
+        std::string phone;
+        std::string address;
+        std::string password; // stored as plain-text for now — replace with secure hash in production
+    };
+
+    static const std::string kEmpty;
+
+    void setProfileField(std::string Profile::*field, std::string value);
+
     std::int32_t m_id;
     std::string m_name;
-    std::string m_email;
-    std::string m_phone;
-    std::string m_address;
-    std::string m_password; // stored as plain-text for now — replace with secure hash in production
-}; 
\ No newline at end of file
+    std::unique_ptr<Profile> m_profile;   // nullptr while every cold field is empty
+};
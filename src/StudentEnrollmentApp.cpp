@@ -1,7 +1,12 @@
 #include "StudentEnrollmentApp.h"
+#include "BulkImporter.h"
+#include "Epoch.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <string>
 
 // ImGui includes
 #include <imgui.h>
@@ -12,12 +17,94 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+namespace {
+
+// Height of the scrolling tables, in rows.
+constexpr float kTableHeightInRows = 15.0f;
+
+// Copies the current table's sort order into (column, ascending) if the
+// user changed it.
+void takeSortSpecs(int& column, bool& ascending) {
+    ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+    if (!specs || !specs->SpecsDirty) {
+        return;
+    }
+    if (specs->SpecsCount > 0) {
+        column = specs->Specs[0].ColumnIndex;
+        ascending = specs->Specs[0].SortDirection != ImGuiSortDirection_Descending;
+    }
+    specs->SpecsDirty = false;
+}
+
+// Sorts rows by key(row), then by id so equal keys keep a stable order.
+template <typename T, typename Key>
+void sortRows(std::vector<const T*>& rows, Key key, bool ascending) {
+    std::sort(rows.begin(), rows.end(), [&](const T* a, const T* b) {
+        decltype(auto) keyA = key(*a);
+        decltype(auto) keyB = key(*b);
+        if (keyA != keyB) {
+            return ascending ? keyA < keyB : keyB < keyA;
+        }
+        return ascending ? a->id() < b->id() : b->id() < a->id();
+    });
+}
+
+template <typename T>
+std::vector<std::int32_t> idsOf(const std::vector<const T*>& rows) {
+    std::vector<std::int32_t> ids;
+    ids.reserve(rows.size());
+    for (const T* row : rows) {
+        ids.push_back(row->id());
+    }
+    return ids;
+}
+
+// Calls fn(object) for everything in `registry` in id order, one page at a
+// time, so a worker job holds the registry's index lock only briefly and
+// writes from the UI thread never wait long behind it. Stops early if the
+// job is cancelled.
+template <typename Registry, typename Fn>
+void forEachInChunks(const Registry& registry, BackgroundWorker::Progress& progress, Fn&& fn) {
+    constexpr std::size_t kChunk = 1024;
+    std::size_t done = 0;
+    std::int32_t lastId = 0;
+    for (bool first = true;; first = false) {
+        std::size_t seen = 0;
+        for (const auto& item : first ? registry.firstPage(kChunk) : registry.page(lastId, kChunk)) {
+            fn(item);
+            lastId = item.id();
+            ++seen;
+        }
+        done += seen;
+        progress.setDone(done);
+        if (seen < kChunk || progress.cancelled()) {
+            return;
+        }
+    }
+}
+
+} // namespace
+
 StudentEnrollmentApp::StudentEnrollmentApp() {
     // Initialize business logic components
     m_students = std::make_unique<StudentRegistry>();
     m_courses = std::make_unique<CourseRegistry>();
     m_enrollmentManager = std::make_unique<EnrollmentManager>(*m_students, *m_courses);
     m_waitlistManager = std::make_unique<WaitlistManager>();
+    m_enrollmentManager->setWaitlistManager(m_waitlistManager.get());
+    m_reports = std::make_unique<ReportAggregates>();
+    m_enrollmentManager->setAggregates(m_reports.get());
+    m_waitlistManager->setAggregates(m_reports.get());
+    m_worker = std::make_unique<BackgroundWorker>();
+
+    // Restore the previous session if there is one
+    m_store = std::make_unique<PersistentStore>(*m_students, *m_courses, *m_enrollmentManager, *m_waitlistManager);
+    if (!m_store->open(kDataFile)) {
+        std::cerr << "Running without persistence: " << m_store->lastError() << "\n";
+    }
+    if (m_store->restoredData()) {
+        return;
+    }
 
     // Add some sample data
     m_students->addStudent(std::make_unique<Student>(1, "Alice Johnson", "alice@university.edu"));
@@ -83,6 +170,8 @@ bool StudentEnrollmentApp::initialize() {
 void StudentEnrollmentApp::run() {
     while (!glfwWindowShouldClose(m_window) && !m_shouldClose) {
         glfwPollEvents();
+        // Publish whatever background jobs finished since the last frame
+        m_worker->poll();
 
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
@@ -100,6 +189,7 @@ void StudentEnrollmentApp::run() {
         if (m_showEnrollmentWindow) renderEnrollmentManagement();
         if (m_showReportsWindow) renderReportsView();
         if (m_showWaitlistWindow) renderWaitlistView();
+        if (m_showImportWindow) renderImportView();
 
         // Rendering
         ImGui::Render();
@@ -116,6 +206,12 @@ void StudentEnrollmentApp::run() {
 
 void StudentEnrollmentApp::shutdown() {
     if (m_window) {
+        // Stop a running import (at its next chunk) before the checkpoint
+        m_worker->stop();
+        if (!m_store->checkpoint() && !m_store->lastError().empty()) {
+            std::cerr << "Failed to save data: " << m_store->lastError() << "\n";
+        }
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -128,6 +224,10 @@ void StudentEnrollmentApp::shutdown() {
 
 void StudentEnrollmentApp::renderMainMenuBar() {
     if (ImGui::BeginMainMenuBar()) {
+        if (ImGui::BeginMenu("File")) {
+            ImGui::MenuItem("Import...", nullptr, &m_showImportWindow);
+            ImGui::EndMenu();
+        }
         if (ImGui::BeginMenu("Windows")) {
             ImGui::MenuItem("Students", nullptr, &m_showStudentWindow);
             ImGui::MenuItem("Courses", nullptr, &m_showCourseWindow);
@@ -153,37 +253,114 @@ void StudentEnrollmentApp::renderStudentManagement() {
         
         ImGui::Separator();
         ImGui::Text("Current Students:");
+        if (m_studentRows.rebuilding() || m_studentRows.failed()) {
+            ImGui::SameLine();
+            renderProgress(*m_studentRows.rebuild);
+        }
+        ImGui::InputTextWithHint("##StudentSearch", "Search by name or email", m_studentSearch, sizeof(m_studentSearch));
         
         // Students table
-        if (ImGui::BeginTable("StudentsTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
-            ImGui::TableSetupColumn("ID");
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable |
+                                      ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("StudentsTable", 4, flags, ImVec2(0, kTableHeightInRows * ImGui::GetTextLineHeightWithSpacing()))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_DefaultSort);
             ImGui::TableSetupColumn("Name");
             ImGui::TableSetupColumn("Email");
-            ImGui::TableSetupColumn("Actions");
+            ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_NoSort);
             ImGui::TableHeadersRow();
-
-            for (const Student* student : m_students->allStudents()) {
-                ImGui::TableNextRow();
-                ImGui::TableNextColumn();
-                ImGui::Text("%d", student->id());
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", student->name().c_str());
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", student->email().c_str());
-                ImGui::TableNextColumn();
-                
-                ImGui::PushID(student->id());
-                if (ImGui::Button("Remove")) {
-                    m_students->removeStudent(student->id());
+            takeSortSpecs(m_studentRows.sortColumn, m_studentRows.ascending);
+            refreshStudentRows();
+
+            std::int32_t removeId = 0;
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_studentRows.ids.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const std::int32_t id = m_studentRows.ids[static_cast<std::size_t>(row)];
+                    const Student* student = m_students->findStudent(id);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    if (!student) {
+                        // Removed since the rows were built
+                        ImGui::TextDisabled("%d", id);
+                        continue;
+                    }
+                    ImGui::Text("%d", id);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", student->name().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", student->email().c_str());
+                    ImGui::TableNextColumn();
+                    
+                    ImGui::PushID(id);
+                    if (ImGui::Button("Remove")) {
+                        removeId = id;
+                    }
+                    ImGui::PopID();
                 }
-                ImGui::PopID();
             }
             ImGui::EndTable();
+            if (removeId != 0) {
+                m_students->removeStudent(removeId);
+            }
         }
     }
     ImGui::End();
 }
 
+void StudentEnrollmentApp::refreshStudentRows() {
+    RowCache& cache = m_studentRows;
+    const RowCache::Inputs inputs{m_students->version(), m_studentSearch, cache.sortColumn, cache.ascending};
+    if (!cache.needsRebuild(inputs)) {
+        return;
+    }
+    cache.requested = inputs;
+    cache.rebuild = m_worker->submit("Sorting students", [this, inputs](BackgroundWorker::Progress& progress)
+                                                             -> BackgroundWorker::Completion {
+        RowCache::Inputs built = inputs;
+        std::vector<std::int32_t> ids;
+        readConsistent([&] { return std::array<std::uint64_t, 1>{built.version = m_students->version()}; },
+                       [&] { ids = buildStudentRows(inputs.filter, inputs.sortColumn, inputs.ascending, progress); },
+                       progress);
+        return [this, ids = std::move(ids), built]() mutable {
+            m_studentRows.ids = std::move(ids);
+            m_studentRows.built = built;
+        };
+    });
+}
+
+// Runs on the worker thread.
+std::vector<std::int32_t> StudentEnrollmentApp::buildStudentRows(const std::string& search, int sortColumn,
+                                                                 bool ascending,
+                                                                 BackgroundWorker::Progress& progress) const {
+    // Keeps the students alive while they are sorted, should the UI remove one meanwhile.
+    Epoch::Guard guard;
+    std::vector<const Student*> rows;
+    if (search.find_first_not_of(" \t") == std::string::npos) {
+        progress.setTotal(m_students->size());
+        forEachInChunks(*m_students, progress, [&](const Student& student) { rows.push_back(&student); });
+    } else if (search.find('@') != std::string::npos) {
+        if (const Student* student = m_students->findStudentByEmail(search)) {
+            rows.push_back(student);
+        }
+    } else {
+        rows = m_students->searchStudentsByName(search);
+    }
+    switch (sortColumn) {
+        case 1:
+            sortRows(rows, [](const Student& s) -> const std::string& { return s.name(); }, ascending);
+            break;
+        case 2:
+            sortRows(rows, [](const Student& s) -> const std::string& { return s.email(); }, ascending);
+            break;
+        default:
+            sortRows(rows, [](const Student& s) { return s.id(); }, ascending);
+            break;
+    }
+    return idsOf(rows);
+}
+
 void StudentEnrollmentApp::renderAddStudentForm() {
     ImGui::Text("Add New Student:");
     ImGui::InputInt("Student ID", &m_studentForm.id);
@@ -216,39 +393,157 @@ void StudentEnrollmentApp::renderCourseManagement() {
         
         ImGui::Separator();
         ImGui::Text("Current Courses:");
+        if (m_courseRows.rebuilding() || m_courseRows.failed()) {
+            ImGui::SameLine();
+            renderProgress(*m_courseRows.rebuild);
+        }
+        ImGui::InputTextWithHint("##CourseName", "Name", m_courseFilter.name, sizeof(m_courseFilter.name));
+        ImGui::InputTextWithHint("##CourseInstructor", "Instructor", m_courseFilter.instructor,
+                                 sizeof(m_courseFilter.instructor));
+        ImGui::DragIntRange2("Credits", &m_courseFilter.minCredits, &m_courseFilter.maxCredits, 0.2f, 0, 255);
         
-        if (ImGui::BeginTable("CoursesTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
-            ImGui::TableSetupColumn("ID");
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable |
+                                      ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("CoursesTable", 6, flags, ImVec2(0, kTableHeightInRows * ImGui::GetTextLineHeightWithSpacing()))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_DefaultSort);
             ImGui::TableSetupColumn("Name");
             ImGui::TableSetupColumn("Credits");
+            ImGui::TableSetupColumn("Seats", ImGuiTableColumnFlags_NoSort);
             ImGui::TableSetupColumn("Instructor");
-            ImGui::TableSetupColumn("Actions");
+            ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_NoSort);
             ImGui::TableHeadersRow();
-
-            for (const Course* course : m_courses->allCourses()) {
-                ImGui::TableNextRow();
-                ImGui::TableNextColumn();
-                ImGui::Text("%d", course->id());
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", course->name().c_str());
-                ImGui::TableNextColumn();
-                ImGui::Text("%d", static_cast<int>(course->credits()));
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", course->instructor().c_str());
-                ImGui::TableNextColumn();
-                
-                ImGui::PushID(course->id());
-                if (ImGui::Button("Remove")) {
-                    m_courses->removeCourse(course->id());
+            takeSortSpecs(m_courseRows.sortColumn, m_courseRows.ascending);
+            refreshCourseRows();
+
+            std::int32_t removeId = 0;
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_courseRows.ids.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const std::int32_t id = m_courseRows.ids[static_cast<std::size_t>(row)];
+                    const Course* course = m_courses->findCourse(id);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    if (!course) {
+                        // Removed since the rows were built
+                        ImGui::TextDisabled("%d", id);
+                        continue;
+                    }
+                    ImGui::Text("%d", id);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", course->name().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", static_cast<int>(course->credits()));
+                    ImGui::TableNextColumn();
+                    // Seats change with every enrollment, so they are read live for the visible rows only.
+                    const std::size_t taken = m_enrollmentManager->activeEnrollmentCount(id);
+                    if (course->hasCapacityLimit()) {
+                        ImGui::Text("%zu/%d", taken, static_cast<int>(course->capacity()));
+                    } else {
+                        ImGui::Text("%zu/-", taken);
+                    }
+                    ImGui::TableNextColumn();
+                    const std::string_view instructor = course->instructor();
+                    ImGui::Text("%.*s", static_cast<int>(instructor.size()), instructor.data());
+                    ImGui::TableNextColumn();
+                    
+                    ImGui::PushID(id);
+                    if (ImGui::Button("Remove")) {
+                        removeId = id;
+                    }
+                    ImGui::PopID();
                 }
-                ImGui::PopID();
             }
             ImGui::EndTable();
+            if (removeId != 0) {
+                m_courses->removeCourse(removeId);
+            }
         }
     }
     ImGui::End();
 }
 
+void StudentEnrollmentApp::refreshCourseRows() {
+    RowCache& cache = m_courseRows;
+    const CourseFilter filter = m_courseFilter;
+    const RowCache::Inputs inputs{m_courses->version(),
+                                  std::string(filter.name) + '\n' + PrefixIndex::normalizeKey(filter.instructor) +
+                                      '\n' + std::to_string(filter.minCredits) + '-' +
+                                      std::to_string(filter.maxCredits),
+                                  cache.sortColumn, cache.ascending};
+    if (!cache.needsRebuild(inputs)) {
+        return;
+    }
+    cache.requested = inputs;
+    cache.rebuild = m_worker->submit("Sorting courses", [this, filter, inputs](BackgroundWorker::Progress& progress)
+                                                            -> BackgroundWorker::Completion {
+        RowCache::Inputs built = inputs;
+        std::vector<std::int32_t> ids;
+        readConsistent([&] { return std::array<std::uint64_t, 1>{built.version = m_courses->version()}; },
+                       [&] { ids = buildCourseRows(filter, inputs.sortColumn, inputs.ascending, progress); },
+                       progress);
+        return [this, ids = std::move(ids), built]() mutable {
+            m_courseRows.ids = std::move(ids);
+            m_courseRows.built = built;
+        };
+    });
+}
+
+// Runs on the worker thread.
+std::vector<std::int32_t> StudentEnrollmentApp::buildCourseRows(const CourseFilter& filter, int sortColumn,
+                                                                bool ascending,
+                                                                BackgroundWorker::Progress& progress) const {
+    const std::string name = filter.name;
+    const std::string instructor = PrefixIndex::normalizeKey(filter.instructor);
+    // Instructors compare by interned key; a name never interned matches no course.
+    StringPool::Id instructorKey = StringPool::kEmpty;
+    const bool instructorKnown = StringPool::instructors().find(instructor, instructorKey);
+    const auto minCredits = static_cast<std::uint8_t>(std::clamp(filter.minCredits, 0, 255));
+    const auto maxCredits = static_cast<std::uint8_t>(std::clamp(filter.maxCredits, 0, 255));
+    const bool byName = name.find_first_not_of(" \t") != std::string::npos;
+    const bool byCredits = minCredits > 0 || maxCredits < 255;
+
+    // Keeps the courses alive while they are sorted, should the UI remove one meanwhile.
+    Epoch::Guard guard;
+    std::vector<const Course*> rows;
+    auto keep = [&](const Course* course) {
+        if ((instructor.empty() || (instructorKnown && course->instructorKey() == instructorKey)) &&
+            course->credits() >= minCredits && course->credits() <= maxCredits) {
+            rows.push_back(course);
+        }
+    };
+    // The narrowest set field picks the index to scan; the rest filter its results.
+    if (byName) {
+        for (const Course* course : m_courses->searchCoursesByName(name)) keep(course);
+    } else if (!instructor.empty()) {
+        if (instructorKnown) {
+            for (const Course& course : m_courses->coursesByInstructor(instructorKey)) keep(&course);
+        }
+    } else if (byCredits) {
+        for (const Course& course : m_courses->coursesByCredits(minCredits, maxCredits)) keep(&course);
+    } else {
+        progress.setTotal(m_courses->size());
+        forEachInChunks(*m_courses, progress, [&](const Course& course) { rows.push_back(&course); });
+    }
+
+    switch (sortColumn) {
+        case 1:
+            sortRows(rows, [](const Course& c) -> const std::string& { return c.name(); }, ascending);
+            break;
+        case 2:
+            sortRows(rows, [](const Course& c) { return c.credits(); }, ascending);
+            break;
+        case 4:
+            sortRows(rows, [](const Course& c) { return c.instructor(); }, ascending);
+            break;
+        default:
+            sortRows(rows, [](const Course& c) { return c.id(); }, ascending);
+            break;
+    }
+    return idsOf(rows);
+}
+
 void StudentEnrollmentApp::renderAddCourseForm() {
     ImGui::Text("Add New Course:");
     ImGui::InputInt("Course ID", &m_courseForm.id);
@@ -256,6 +551,7 @@ void StudentEnrollmentApp::renderAddCourseForm() {
     ImGui::InputInt("Credits", &m_courseForm.credits);
     ImGui::InputText("Instructor", m_courseForm.instructor, sizeof(m_courseForm.instructor));
     ImGui::InputText("Prerequisites (comma-separated IDs)", m_courseForm.prerequisiteInput, sizeof(m_courseForm.prerequisiteInput));
+    ImGui::InputInt("Capacity (-1 = unlimited, 0 = closed)", &m_courseForm.capacity);
     
     if (ImGui::Button("Add Course")) {
         if (m_courseForm.id > 0 && strlen(m_courseForm.name) > 0) {
@@ -277,11 +573,28 @@ void StudentEnrollmentApp::renderAddCourseForm() {
                 std::string(m_courseForm.name),
                 static_cast<std::uint8_t>(std::max(1, std::min(10, m_courseForm.credits))),
                 std::string(m_courseForm.instructor),
-                prerequisites
+                prerequisites,
+                m_courseForm.capacity < 0
+                    ? Course::kUnlimitedCapacity
+                    : static_cast<std::uint16_t>(std::min<int>(Course::kUnlimitedCapacity - 1, m_courseForm.capacity))
             );
             
             if (m_courses->addCourse(std::move(course))) {
                 m_courseForm = CourseForm{};
+            } else {
+                const char* message = "Course ID already exists!";
+                switch (m_courses->checkPrerequisites(m_courseForm.id, prerequisites)) {
+                    case PrerequisiteGraph::Result::UnknownPrerequisite:
+                        message = "Unknown prerequisite course!";
+                        break;
+                    case PrerequisiteGraph::Result::Cycle:
+                        message = "Prerequisites would form a cycle!";
+                        break;
+                    default:
+                        break;
+                }
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s", message);
             }
         }
     }
@@ -294,30 +607,54 @@ void StudentEnrollmentApp::renderEnrollmentManagement() {
         ImGui::Separator();
         ImGui::Text("Current Enrollments:");
         
-        if (ImGui::BeginTable("EnrollmentsTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("EnrollmentsTable", 4, flags, ImVec2(0, kTableHeightInRows * ImGui::GetTextLineHeightWithSpacing()))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
             ImGui::TableSetupColumn("Student");
             ImGui::TableSetupColumn("Course");
             ImGui::TableSetupColumn("Status");
             ImGui::TableSetupColumn("Actions");
             ImGui::TableHeadersRow();
 
-            for (const Enrollment* enrollment : m_enrollmentManager->getAllEnrollments()) {
-                const Student* student = m_students->findStudent(enrollment->studentId());
-                const Course* course = m_courses->findCourse(enrollment->courseId());
-                
-                if (student && course) {
+            // Enrollment rows never move, so the clipper addresses them by
+            // row number and nothing needs caching. Removed students and
+            // courses show as their id to keep the row count stable. A page
+            // holds no lock, so the buttons act straight away; rows a
+            // promotion appends show up next frame.
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_enrollmentManager->enrollmentCount()));
+            while (clipper.Step()) {
+                std::size_t row = static_cast<std::size_t>(clipper.DisplayStart);
+                const auto count = static_cast<std::size_t>(clipper.DisplayEnd - clipper.DisplayStart);
+                for (const Enrollment& enrollment : m_enrollmentManager->enrollmentsPage(row, count)) {
+                    const Student* student = m_students->findStudent(enrollment.studentId());
+                    const Course* course = m_courses->findCourse(enrollment.courseId());
+                    
                     ImGui::TableNextRow();
                     ImGui::TableNextColumn();
-                    ImGui::Text("%s", student->name().c_str());
+                    if (student) {
+                        ImGui::Text("%s", student->name().c_str());
+                    } else {
+                        ImGui::TextDisabled("#%d", enrollment.studentId());
+                    }
                     ImGui::TableNextColumn();
-                    ImGui::Text("%s", course->name().c_str());
+                    if (course) {
+                        ImGui::Text("%s", course->name().c_str());
+                    } else {
+                        ImGui::TextDisabled("#%d", enrollment.courseId());
+                    }
                     ImGui::TableNextColumn();
-                    ImGui::Text("%s", enrollment->isActive() ? "Active" : "Inactive");
+                    ImGui::Text("%s", enrollment.isActive() ? "Active" : "Inactive");
                     ImGui::TableNextColumn();
                     
-                    ImGui::PushID(enrollment->studentId() * 1000 + enrollment->courseId());
-                    if (ImGui::Button("Drop") && enrollment->isActive()) {
-                        m_enrollmentManager->dropStudent(enrollment->studentId(), enrollment->courseId());
+                    ImGui::PushID(static_cast<int>(row++));
+                    if (ImGui::Button("Drop") && enrollment.isActive()) {
+                        m_enrollmentManager->dropStudent(enrollment.studentId(), enrollment.courseId());
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Complete") && enrollment.isActive()) {
+                        m_enrollmentManager->setEnrollmentStatus(enrollment.studentId(), enrollment.courseId(),
+                                                                 Enrollment::Status::Completed);
                     }
                     ImGui::PopID();
                 }
@@ -356,7 +693,7 @@ void StudentEnrollmentApp::renderEnrollStudentForm() {
                 message = "Student already enrolled!";
                 break;
             case EnrollmentManager::EnrollmentResult::CourseFull:
-                message = "Course is full!";
+                message = "Course is full - added to the waitlist.";
                 break;
         }
         
@@ -374,16 +711,72 @@ void StudentEnrollmentApp::renderReportsView() {
     if (ImGui::Begin("Reports", &m_showReportsWindow)) {
         ImGui::Text("Enrollment Statistics:");
         
-        ImGui::Text("Total Students: %zu", m_students->allStudents().size());
-        ImGui::Text("Total Courses: %zu", m_courses->allCourses().size());
-        ImGui::Text("Total Enrollments: %zu", m_enrollmentManager->getAllEnrollments().size());
+        ImGui::Text("Total Students: %zu", m_students->size());
+        ImGui::Text("Total Courses: %zu", m_courses->size());
+        ImGui::Text("Total Enrollments: %zu (active %zu, completed %zu, dropped %zu, withdrawn %zu)",
+                    m_reports->totalEnrollments(),
+                    m_reports->totalWithStatus(Enrollment::Status::Active),
+                    m_reports->totalWithStatus(Enrollment::Status::Completed),
+                    m_reports->totalWithStatus(Enrollment::Status::Dropped),
+                    m_reports->totalWithStatus(Enrollment::Status::Withdrawn));
         
         ImGui::Separator();
         ImGui::Text("Course Enrollment Details:");
-        
-        for (const Course* course : m_courses->allCourses()) {
-            auto enrollments = m_enrollmentManager->getCourseEnrollments(course->id());
-            ImGui::Text("%s: %zu students enrolled", course->name().c_str(), enrollments.size());
+        refreshReportLines();
+        if (m_reportLines.rebuilding() || m_reportLines.failed()) {
+            renderProgress(*m_reportLines.rebuild);
+        }
+        if (ImGui::BeginChild("CourseDetails", ImVec2(0, kTableHeightInRows * ImGui::GetTextLineHeightWithSpacing()))) {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_reportLines.lines.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    ImGui::TextUnformatted(m_reportLines.lines[static_cast<std::size_t>(i)].c_str());
+                }
+            }
+        }
+        ImGui::EndChild();
+
+        if (Metrics::enabled()) {
+            ImGui::Separator();
+            ImGui::Text("Operation Latency (live):");
+            const auto now = std::chrono::steady_clock::now();
+            if (now - m_metricsTakenAt >= kMetricsRefresh) {
+                m_metrics = Metrics::snapshot();
+                m_metricsTakenAt = now;
+            }
+            const Metrics::Snapshot& metrics = m_metrics;
+            if (ImGui::BeginTable("Latency", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Operation");
+                ImGui::TableSetupColumn("Calls");
+                ImGui::TableSetupColumn("p50 (us)");
+                ImGui::TableSetupColumn("p99 (us)");
+                ImGui::TableHeadersRow();
+                for (const Metrics::OperationStats& op : metrics.operations) {
+                    if (op.count == 0) continue;
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", op.name);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(op.count));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", op.p50Ns / 1000.0);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", op.p99Ns / 1000.0);
+                }
+                ImGui::EndTable();
+            }
+            for (const Metrics::CounterValue& counter : metrics.counters) {
+                ImGui::Text("%s: %llu", counter.name, static_cast<unsigned long long>(counter.value));
+            }
+            if (ImGui::Button("Copy as JSON")) {
+                ImGui::SetClipboardText(metrics.toJson().c_str());
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Reset")) {
+                Metrics::reset();
+                m_metricsTakenAt = {};   // show the cleared numbers on the next frame
+            }
         }
     }
     ImGui::End();
@@ -392,21 +785,165 @@ void StudentEnrollmentApp::renderReportsView() {
 void StudentEnrollmentApp::renderWaitlistView() {
     if (ImGui::Begin("Waitlists", &m_showWaitlistWindow)) {
         ImGui::Text("Course Waitlists:");
+        refreshWaitlistLines();
+        if (m_waitlistLines.rebuilding() || m_waitlistLines.failed()) {
+            renderProgress(*m_waitlistLines.rebuild);
+        }
         
-        for (const Course* course : m_courses->allCourses()) {
-            auto waitlistSize = m_waitlistManager->getWaitlistSize(course->id());
-            if (waitlistSize > 0) {
-                ImGui::Text("%s: %zu students waiting", course->name().c_str(), waitlistSize);
-                
-                auto waitlist = m_waitlistManager->getWaitlist(course->id());
-                for (size_t i = 0; i < waitlist.size(); ++i) {
-                    const Student* student = m_students->findStudent(waitlist[i]);
-                    if (student) {
-                        ImGui::Text("  %zu. %s", i + 1, student->name().c_str());
+        if (ImGui::BeginChild("WaitlistLines")) {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_waitlistLines.lines.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    ImGui::TextUnformatted(m_waitlistLines.lines[static_cast<std::size_t>(i)].c_str());
+                }
+            }
+        }
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
+
+std::array<std::uint64_t, 3> StudentEnrollmentApp::waitlistSources() const {
+    return {m_waitlistManager->version(), m_students->version(), m_courses->version()};
+}
+
+std::array<std::uint64_t, 3> StudentEnrollmentApp::reportSources() const {
+    return {m_enrollmentManager->version(), m_waitlistManager->version(), m_courses->version()};
+}
+
+void StudentEnrollmentApp::refreshWaitlistLines() {
+    const TextCache::Versions current = waitlistSources();
+    if (!m_waitlistLines.needsRebuild(current)) {
+        return;
+    }
+    m_waitlistLines.requested = current;
+    m_waitlistLines.rebuild = m_worker->submit("Resolving waitlists", [this](BackgroundWorker::Progress& progress)
+                                                                          -> BackgroundWorker::Completion {
+        // Keeps the waitlisted students alive while their names are read, should the UI remove one meanwhile.
+        Epoch::Guard guard;
+        std::vector<std::string> lines;
+        TextCache::Versions versions{};
+        readConsistent([&] { return versions = waitlistSources(); }, [&] {
+            lines.clear();
+            progress.setTotal(m_courses->size());
+            forEachInChunks(*m_courses, progress, [&](const Course& course) {
+                if (m_waitlistManager->isWaitlistEmpty(course.id())) {
+                    return;
+                }
+                const std::vector<std::int32_t> waitlist = m_waitlistManager->getWaitlist(course.id());
+                lines.push_back(course.name() + ": " + std::to_string(waitlist.size()) + " students waiting");
+                for (std::size_t i = 0; i < waitlist.size(); ++i) {
+                    if (const Student* student = m_students->findStudent(waitlist[i])) {
+                        lines.push_back("  " + std::to_string(i + 1) + ". " + student->name());
                     }
                 }
+            });
+        }, progress);
+        return [this, lines = std::move(lines), versions]() mutable {
+            m_waitlistLines.lines = std::move(lines);
+            m_waitlistLines.versions = versions;
+        };
+    });
+}
+
+void StudentEnrollmentApp::refreshReportLines() {
+    const TextCache::Versions current = reportSources();
+    if (!m_reportLines.needsRebuild(current)) {
+        return;
+    }
+    m_reportLines.requested = current;
+    m_reportLines.rebuild = m_worker->submit("Building course report", [this](BackgroundWorker::Progress& progress)
+                                                                             -> BackgroundWorker::Completion {
+        std::vector<std::string> lines;
+        TextCache::Versions versions{};
+        readConsistent([&] { return versions = reportSources(); }, [&] {
+            lines.clear();
+            progress.setTotal(m_courses->size());
+            forEachInChunks(*m_courses, progress, [&](const Course& course) {
+                const ReportAggregates::CourseTotals totals = m_reports->courseTotals(course.id());
+                lines.push_back(course.name() + ": " + std::to_string(totals.count(Enrollment::Status::Active)) +
+                                " students enrolled, " + std::to_string(totals.count(Enrollment::Status::Completed)) +
+                                " completed, " + std::to_string(totals.waitlisted) + " waitlisted");
+            });
+        }, progress);
+        return [this, lines = std::move(lines), versions]() mutable {
+            m_reportLines.lines = std::move(lines);
+            m_reportLines.versions = versions;
+        };
+    });
+}
+
+void StudentEnrollmentApp::renderImportView() {
+    if (ImGui::Begin("Import", &m_showImportWindow)) {
+        ImGui::InputText("File", m_importForm.path, sizeof(m_importForm.path));
+        ImGui::RadioButton("Students", &m_importForm.kind, 0);
+        ImGui::SameLine();
+        ImGui::RadioButton("Courses", &m_importForm.kind, 1);
+        ImGui::SameLine();
+        ImGui::RadioButton("Enrollments", &m_importForm.kind, 2);
+
+        if (m_importForm.job && !m_importForm.job->finished()) {
+            renderProgress(*m_importForm.job);
+            if (!m_importForm.job->cancelled() && ImGui::Button("Cancel")) {
+                m_importForm.job->cancel();
             }
+        } else if (ImGui::Button("Import") && m_importForm.path[0] != '\0') {
+            const std::string path = m_importForm.path;
+            const int kind = m_importForm.kind;
+            m_importForm.result.clear();
+            m_importForm.job = m_worker->submit("Importing " + path, [this, path, kind](
+                                                                         BackgroundWorker::Progress& progress)
+                                                                         -> BackgroundWorker::Completion {
+                BulkImporter importer(*m_students, *m_courses, *m_enrollmentManager);
+                importer.setProgressCallback([&progress](std::size_t bytesRead, std::size_t fileBytes) {
+                    progress.setTotal(fileBytes);
+                    progress.setDone(bytesRead);
+                    return !progress.cancelled();
+                });
+                const BulkImporter::Report report = kind == 0   ? importer.importStudents(path)
+                                                    : kind == 1 ? importer.importCourses(path)
+                                                                : importer.importEnrollments(path);
+                std::ostringstream summary;
+                if (!report.fileOpened) {
+                    summary << "Could not open " << path;
+                } else {
+                    summary << "Imported " << report.rowsImported << " of " << report.rowsRead << " rows in "
+                            << report.seconds << " s";
+                    if (report.errorCount > 0) {
+                        summary << "; " << report.errorCount << " errors, first at line "
+                                << report.errors.front().line << ": " << report.errors.front().message;
+                    }
+                }
+                return [this, text = summary.str()] { m_importForm.result = text; };
+            });
+        }
+        if (m_importForm.job && m_importForm.job->failed()) {
+            renderProgress(*m_importForm.job);
+        } else if (m_importForm.job && m_importForm.job->finished() && m_importForm.job->cancelled()) {
+            ImGui::TextWrapped("Import cancelled; rows read before it stopped stay imported.");
+        } else if (!m_importForm.result.empty()) {
+            ImGui::TextWrapped("%s", m_importForm.result.c_str());
         }
     }
     ImGui::End();
 }
+
+void StudentEnrollmentApp::renderProgress(const BackgroundWorker::Progress& progress) {
+    if (progress.failed()) {
+        ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s failed: %s", progress.label().c_str(), progress.error().c_str());
+        return;
+    }
+    if (!progress.running()) {
+        ImGui::TextDisabled("%s (queued)", progress.label().c_str());
+        return;
+    }
+    const float fraction = progress.fraction();
+    if (fraction < 0.0f) {
+        ImGui::TextDisabled("%s...", progress.label().c_str());
+        return;
+    }
+    char overlay[300];
+    std::snprintf(overlay, sizeof(overlay), "%s %.0f%%", progress.label().c_str(), fraction * 100.0f);
+    ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0), overlay);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -7,6 +10,9 @@
 #include "CourseRegistry.h"
 #include "EnrollmentManager.h"
 #include "WaitlistManager.h"
+#include "PersistentStore.h"
+#include "ReportAggregates.h"
+#include "BackgroundWorker.h"
 
 // Main application class that manages the GUI and coordinates all subsystems
 class StudentEnrollmentApp {
@@ -33,12 +39,74 @@ private:
     void renderAddCourseForm();
     void renderEnrollStudentForm();
 
+    // Row order of a table, rebuilt on the background worker when the
+    // source's version(), the filter text or the sort order changes. Rows
+    // are ids, looked up as they are drawn, and tables draw only the rows
+    // ImGuiListClipper reports visible, so a frame costs O(visible rows)
+    // however large the table is and never waits for a rebuild.
+    struct RowCache {
+        // What a row order is built from
+        struct Inputs {
+            std::uint64_t version = UINT64_MAX;   // source version()
+            std::string filter;
+            int sortColumn = -1;
+            bool ascending = true;
+
+            bool operator==(const Inputs& other) const {
+                return version == other.version && filter == other.filter && sortColumn == other.sortColumn &&
+                       ascending == other.ascending;
+            }
+        };
+        std::vector<std::int32_t> ids;
+        Inputs built;           // inputs the ids were built from
+        Inputs requested;       // inputs of the latest rebuild
+        int sortColumn = 0;     // order asked for through the table header
+        bool ascending = true;
+        std::shared_ptr<const BackgroundWorker::Progress> rebuild;
+
+        // A rebuild that failed is retried only once the inputs change again.
+        bool needsRebuild(const Inputs& current) const {
+            return !rebuilding() && !(current == built) && !(failed() && current == requested);
+        }
+        bool rebuilding() const { return rebuild && !rebuild->finished(); }
+        bool failed() const { return rebuild && rebuild->failed(); }
+    };
+    void refreshStudentRows();
+    void refreshCourseRows();
+    std::vector<std::int32_t> buildStudentRows(const std::string& search, int sortColumn, bool ascending,
+                                               BackgroundWorker::Progress& progress) const;
+
+    // Text of a read-only window, rebuilt on the worker when any of the
+    // version() counters it was built from moves
+    struct TextCache {
+        using Versions = std::array<std::uint64_t, 3>;
+        std::vector<std::string> lines;
+        Versions versions{UINT64_MAX, UINT64_MAX, UINT64_MAX};    // versions the lines were built from
+        Versions requested{UINT64_MAX, UINT64_MAX, UINT64_MAX};   // versions when the latest rebuild was asked for
+        std::shared_ptr<const BackgroundWorker::Progress> rebuild;
+
+        // A rebuild that failed is retried only once a version moves again.
+        bool needsRebuild(const Versions& current) const {
+            return !rebuilding() && current != versions && !(failed() && current == requested);
+        }
+        bool rebuilding() const { return rebuild && !rebuild->finished(); }
+        bool failed() const { return rebuild && rebuild->failed(); }
+    };
+    void refreshWaitlistLines();
+    void refreshReportLines();
+    std::array<std::uint64_t, 3> waitlistSources() const;
+    std::array<std::uint64_t, 3> reportSources() const;
+
+    void renderImportView();
+    static void renderProgress(const BackgroundWorker::Progress& progress);
+
     // Application state
     bool m_showStudentWindow = true;
     bool m_showCourseWindow = true;
     bool m_showEnrollmentWindow = true;
     bool m_showReportsWindow = false;
     bool m_showWaitlistWindow = false;
+    bool m_showImportWindow = false;
 
     // Form state
     struct StudentForm {
@@ -48,16 +116,47 @@ private:
         char address[512] = "";
         int id = 0;
     } m_studentForm;
+    char m_studentSearch[256] = "";   // name prefix or email filter for the students table
+
+    RowCache m_studentRows;
 
     struct CourseForm {
         char name[256] = "";
         char instructor[256] = "";
         int id = 0;
         int credits = 3;
+        int capacity = -1;   // unlimited
         std::vector<int> prerequisites;
         char prerequisiteInput[256] = "";
     } m_courseForm;
 
+    // Courses table filter; the narrowest set field picks the index to scan
+    struct CourseFilter {
+        char name[256] = "";
+        char instructor[256] = "";
+        int minCredits = 0;
+        int maxCredits = 255;
+    } m_courseFilter;
+    RowCache m_courseRows;
+    std::vector<std::int32_t> buildCourseRows(const CourseFilter& filter, int sortColumn, bool ascending,
+                                              BackgroundWorker::Progress& progress) const;
+
+    TextCache m_waitlistLines;
+    TextCache m_reportLines;   // per-course lines of the reports window
+
+    // Latency table of the reports window. Building a snapshot merges every
+    // thread's histograms, so it is refreshed at kMetricsRefresh, not per frame.
+    static constexpr std::chrono::milliseconds kMetricsRefresh{250};
+    Metrics::Snapshot m_metrics;
+    std::chrono::steady_clock::time_point m_metricsTakenAt{};
+
+    struct ImportForm {
+        char path[512] = "";
+        int kind = 0;   // 0 students, 1 courses, 2 enrollments
+        std::shared_ptr<const BackgroundWorker::Progress> job;
+        std::string result;
+    } m_importForm;
+
     struct EnrollmentForm {
         int studentId = 0;
         int courseId = 0;
@@ -68,6 +167,16 @@ private:
     std::unique_ptr<CourseRegistry> m_courses;
     std::unique_ptr<EnrollmentManager> m_enrollmentManager;
     std::unique_ptr<WaitlistManager> m_waitlistManager;
+    std::unique_ptr<ReportAggregates> m_reports;   // running totals for the reports window
+
+    // Persistence: snapshot + write-ahead log under this base name
+    static constexpr const char* kDataFile = "enrollment_data";
+    std::unique_ptr<PersistentStore> m_store;
+
+    // Runs imports and table/report building off the UI thread. Declared
+    // after the core objects so it is destroyed (and its thread joined)
+    // before anything its jobs use.
+    std::unique_ptr<BackgroundWorker> m_worker;
 
     // GUI state
     struct GLFWwindow* m_window = nullptr;
@@ -1,26 +1,265 @@
 #include "StudentRegistry.h"
+#include <algorithm>
+#include "Epoch.h"
 
 bool StudentRegistry::addStudent(std::unique_ptr<Student> student) {
     if (!student) { return false; }
-    const auto id = student->id();
-    auto [it, inserted] = m_students.emplace(id, std::move(student));
-    return inserted;
+    return emplaceStudent(std::move(*student)) != nullptr;
+}
+
+Student* StudentRegistry::insert(Pool::Handle handle, bool restoring) {
+    Student* student = m_pool.get(handle);
+    std::string email = PrefixIndex::normalizeKey(student->email());
+    if (admits(*student, email, restoring) != AddResult::Added) {
+        m_pool.destroy(handle);
+        return nullptr;
+    }
+    {
+        VersionCounter::Change change(m_version);
+        m_index.insert(student->id(), handle);
+        std::unique_lock<std::shared_mutex> lock(m_searchMutex);
+        indexStudent(*student, handle, std::move(email));
+    }
+    if (m_log) {
+        m_log->studentAdded(*student);
+    }
+    return student;
+}
+
+std::vector<StudentRegistry::AddResult> StudentRegistry::addStudents(std::vector<Student>& students) {
+    SES_TIME_OPERATION(StudentAddBatch);
+    std::vector<AddResult> results;
+    results.reserve(students.size());
+    std::vector<const Student*> added;
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        for (Student& candidate : students) {
+            std::string email = PrefixIndex::normalizeKey(candidate.email());
+            results.push_back(admits(candidate, email, false));
+            if (results.back() != AddResult::Added) {
+                continue;
+            }
+            const Pool::Handle handle = m_pool.create(std::move(candidate));
+            const Student* student = m_pool.get(handle);
+            m_index.insert(student->id(), handle);
+            indexStudent(*student, handle, std::move(email));
+            added.push_back(student);
+        }
+    }
+    if (m_log) {
+        for (const Student* student : added) {
+            m_log->studentAdded(*student);
+        }
+    }
+    return results;
+}
+
+StudentRegistry::AddResult StudentRegistry::admits(const Student& student, const std::string& emailKey,
+                                                   bool restoring) const {
+    Pool::Handle existing;
+    if (m_index.find(student.id(), existing)) {
+        return AddResult::IdTaken;
+    }
+    if (!restoring && !emailKey.empty() && m_byEmail.count(emailKey) != 0) {
+        return AddResult::EmailTaken;
+    }
+    return AddResult::Added;
+}
+
+void StudentRegistry::indexStudent(const Student& student, Pool::Handle handle, std::string emailKey) {
+    if (!emailKey.empty()) {
+        // Only a restored student can find its email taken; it waits its turn.
+        const auto owner = m_byEmail.find(emailKey);
+        if (owner != m_byEmail.end()) {
+            m_duplicateEmails[std::move(emailKey)].push_back(handle);
+        } else {
+            m_byEmail.emplace(std::move(emailKey), handle);
+        }
+    }
+    m_byId.insert({student.id(), handle});
+    m_byName.insert(student.name(), handle);
 }
 
 bool StudentRegistry::removeStudent(std::int32_t id) {
-    return m_students.erase(id) > 0;
+    SES_TIME_OPERATION(StudentRemove);
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    if (!m_index.find(id, handle)) {
+        return false;
+    }
+    {
+        VersionCounter::Change change(m_version);
+        m_index.erase(id);
+        const Student* student = m_pool.get(handle);
+        std::unique_lock<std::shared_mutex> lock(m_searchMutex);
+        unindexEmail(PrefixIndex::normalizeKey(student->email()), handle);
+        m_byId.erase({id, handle});
+        m_byName.erase(student->name(), handle);
+    }
+    m_retired.emplace_back(Epoch::retire(), handle);
+    reclaimRemoved();
+    if (m_log) {
+        m_log->studentRemoved(id);
+    }
+    return true;
+}
+
+void StudentRegistry::unindexEmail(const std::string& key, Pool::Handle handle) {
+    const auto owner = m_byEmail.find(key);
+    if (owner == m_byEmail.end()) {
+        return;
+    }
+    const auto duplicates = m_duplicateEmails.find(key);
+    if (owner->second == handle) {
+        if (duplicates == m_duplicateEmails.end()) {
+            m_byEmail.erase(owner);
+            return;
+        }
+        owner->second = duplicates->second.front();
+        duplicates->second.erase(duplicates->second.begin());
+    } else if (duplicates != m_duplicateEmails.end()) {
+        auto& handles = duplicates->second;
+        handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+    } else {
+        return;
+    }
+    if (duplicates->second.empty()) {
+        m_duplicateEmails.erase(duplicates);
+    }
+}
+
+void StudentRegistry::reclaimRemoved() {
+    auto it = m_retired.begin();
+    while (it != m_retired.end() && Epoch::isReclaimable(it->first)) {
+        m_pool.destroy(it->second);
+        ++it;
+    }
+    m_retired.erase(m_retired.begin(), it);
 }
 
 Student* StudentRegistry::findStudent(std::int32_t id) const {
-    auto it = m_students.find(id);
-    return it == m_students.end() ? nullptr : it->second.get();
+    SES_TIME_OPERATION(StudentFind);
+    Epoch::Guard guard;
+    Pool::Handle handle;
+    return m_index.find(id, handle) ? m_pool.get(handle) : nullptr;
 }
 
-std::vector<const Student*> StudentRegistry::allStudents() const {
+Student* StudentRegistry::findStudentByEmail(std::string_view email) const {
+    SES_TIME_OPERATION(StudentFindByEmail);
+    const std::string key = PrefixIndex::normalizeKey(email);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto it = m_byEmail.find(key);
+    return it == m_byEmail.end() ? nullptr : m_pool.get(it->second);
+}
+
+std::vector<const Student*> StudentRegistry::searchStudentsByName(std::string_view query, std::size_t limit) const {
+    SES_TIME_OPERATION(StudentSearch);
     std::vector<const Student*> result;
-    result.reserve(m_students.size());
-    for (const auto& [id, ptr] : m_students) {
-        result.push_back(ptr.get());
+    {
+        std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+        // The index returns matches in its own order, so the name order
+        // is only known once every match is in hand.
+        const std::vector<std::uint32_t> handles = m_byName.search(
+            query, SIZE_MAX, [this](std::uint32_t handle) -> const std::string& { return m_pool.get(handle)->name(); });
+        result.reserve(handles.size());
+        for (std::uint32_t handle : handles) {
+            result.push_back(m_pool.get(handle));
+        }
+    }
+    const std::size_t kept = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(kept), result.end(),
+                      [](const Student* a, const Student* b) {
+                          return a->name() != b->name() ? a->name() < b->name() : a->id() < b->id();
+                      });
+    result.resize(kept);
+    return result;
+}
+
+Student* StudentRegistry::findLocked(std::int32_t id, Pool::Handle& handle) const {
+    return m_index.find(id, handle) ? m_pool.get(handle) : nullptr;
+}
+
+bool StudentRegistry::setName(std::int32_t id, std::string name) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    Student* student = findLocked(id, handle);
+    if (!student) {
+        return false;
+    }
+    {
+        VersionCounter::Change change(m_version);
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        m_byName.erase(student->name(), handle);
+        student->setName(std::move(name));
+        m_byName.insert(student->name(), handle);
+    }
+    if (m_log) {
+        m_log->studentUpdated(*student);
+    }
+    return true;
+}
+
+bool StudentRegistry::setEmail(std::int32_t id, std::string email) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    Pool::Handle handle;
+    Student* student = findLocked(id, handle);
+    if (!student) {
+        return false;
+    }
+    std::string key = PrefixIndex::normalizeKey(email);
+    const std::string oldKey = PrefixIndex::normalizeKey(student->email());
+    {
+        std::unique_lock<std::shared_mutex> searchLock(m_searchMutex);
+        if (!key.empty() && key != oldKey && m_byEmail.count(key) != 0) {
+            return false;
+        }
+        VersionCounter::Change change(m_version);
+        // With the same key (e.g. only the case changed) the student keeps
+        // its place, whether it owns the key or is a restored duplicate.
+        const bool reindex = key != oldKey;
+        if (reindex) {
+            unindexEmail(oldKey, handle);
+        }
+        student->setEmail(std::move(email));
+        if (reindex && !key.empty()) {
+            m_byEmail.emplace(std::move(key), handle);
+        }
+    }
+    if (m_log) {
+        m_log->studentUpdated(*student);
     }
+    return true;
+}
+
+std::vector<const Student*> StudentRegistry::allStudents() const {
+    SES_TIME_OPERATION(StudentList);
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    std::vector<const Student*> result;
+    result.reserve(m_index.size());
+    const bool pendingRemovals = !m_retired.empty();
+    m_pool.forEach([&](const Student& student) {
+        // Removed entries stay in the pool until reclaimed; skip them.
+        Pool::Handle handle;
+        if (pendingRemovals && !(m_index.find(student.id(), handle) && m_pool.get(handle) == &student)) {
+            return;
+        }
+        result.push_back(&student);
+    });
     return result;
-} 
\ No newline at end of file
+}
+
+StudentRegistry::StudentView StudentRegistry::firstPage(std::size_t limit) const {
+    SES_TIME_OPERATION(StudentList);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto first = m_byId.begin();
+    return StudentView(std::move(lock), first, advanceAtMost(first, m_byId.end(), limit), m_pool);
+}
+
+StudentRegistry::StudentView StudentRegistry::page(std::int32_t afterId, std::size_t limit) const {
+    SES_TIME_OPERATION(StudentList);
+    std::shared_lock<std::shared_mutex> lock(m_searchMutex);
+    const auto first = m_byId.upper_bound({afterId, 0});
+    return StudentView(std::move(lock), first, advanceAtMost(first, m_byId.end(), limit), m_pool);
+}
@@ -1,28 +1,151 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
+#include "ConcurrentIdMap.h"
+#include "IndexView.h"
+#include "ObjectPool.h"
+#include "PrefixIndex.h"
 #include "Student.h"
+#include "Metrics.h"
+#include "MutationLog.h"
+#include "VersionCounter.h"
 
 // A small repository class that owns Student objects and provides
-// basic CRUD operations. All ownership is handled through
-// std::unique_ptr, ensuring there are no leaks and every Student
-// instance has a single clear owner.
+// basic CRUD operations. Students live in a slab-backed ObjectPool:
+// the registry is their single owner, their addresses stay stable until
+// they are removed, and tearing the registry down frees whole slabs.
+// Student keeps only its id and name inline, so the slabs are a dense
+// table of what lookups read; contact data sits in per-student profiles
+// off to the side.
+//
+// findStudent() is lock-free and may run concurrently with adds and
+// removes; callers on other threads must hold an Epoch::Guard for as long as
+// they use the returned pointer. A removed student is unlinked at once but
+// destroyed only after every such guard has been released. Writers
+// serialize on an internal mutex.
+//
+// Emails are unique (compared case-insensitively; empty emails are not
+// indexed) and names are searchable by word prefix. Both indexes follow
+// the registry's setName/setEmail; Student's own setters bypass them.
 class StudentRegistry {
+    using Pool = ObjectPool<Student>;
+    using IdIndex = std::set<IdIndexEntry>;
+
 public:
-    // Adds a student. Returns false if a student with the same id already exists.
+    // Students in id order; see IndexView for the locking rules.
+    using StudentView = IndexView<IdIndex::const_iterator, Student>;
+
+    // Adds a student. Returns false if the id or the email is taken.
     bool addStudent(std::unique_ptr<Student> student);
 
+    // Constructs a student in place from Student's constructor arguments,
+    // avoiding a separate heap allocation. Returns nullptr if the id or the
+    // email is taken.
+    template <typename... Args>
+    Student* emplaceStudent(Args&&... args) {
+        SES_TIME_OPERATION(StudentAdd);
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return insert(m_pool.create(std::forward<Args>(args)...), false);
+    }
+    // emplaceStudent for loading saved data: a student whose email is taken
+    // is still added. Only one owner is findable by that email at a time;
+    // when it is removed or changes email, the next one loaded takes over.
+    template <typename... Args>
+    Student* restoreStudent(Args&&... args) {
+        SES_TIME_OPERATION(StudentAdd);
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return insert(m_pool.create(std::forward<Args>(args)...), true);
+    }
+
+    enum class AddResult : std::uint8_t { Added, IdTaken, EmailTaken };
+
+    // Adds `students` in order, as emplaceStudent would one at a time, but
+    // takes the registry's locks once for the whole batch; for bulk loads.
+    // Added students are moved out of the vector, rejected ones are left as
+    // they were. Returns one result per student.
+    std::vector<AddResult> addStudents(std::vector<Student>& students);
+
     // Removes student by id. Returns false if not found.
     bool removeStudent(std::int32_t id);
 
     // Finds a student by id. Returns nullptr if not found.
     Student* findStudent(std::int32_t id) const;
+    // Finds a student by email, ignoring case. Same rules as findStudent.
+    Student* findStudentByEmail(std::string_view email) const;
+    // Students with a name word starting with each word of `query`
+    // (case-insensitive), sorted by name, at most `limit` of them.
+    std::vector<const Student*> searchStudentsByName(std::string_view query, std::size_t limit = SIZE_MAX) const;
 
-    // Returns a snapshot (const pointers) of all students.
+    // Change a registered student's name or email and re-index them. Not
+    // synchronized with other threads reading that student. setEmail
+    // returns false if another student has the email.
+    bool setName(std::int32_t id, std::string name);
+    bool setEmail(std::int32_t id, std::string email);
+
+    // Returns a snapshot (const pointers) of all students, in pool order.
     std::vector<const Student*> allStudents() const;
+    // Pages through students in id order without copying: the first
+    // `limit` students, or the first `limit` with an id above `afterId`
+    // (pass the last id of the previous page). O(log n + limit).
+    StudentView firstPage(std::size_t limit) const;
+    StudentView page(std::int32_t afterId, std::size_t limit) const;
+
+    std::size_t size() const noexcept { return m_index.size(); }
+    // Number of changes made, or VersionCounter::kChanging while one is
+    // under way; two equal readings mean nothing changed in between (e.g.
+    // to keep a cached view). See VersionCounter.
+    std::uint64_t version() const noexcept { return m_version.read(); }
+
+    // Pre-sizes internal storage for bulk loads.
+    void reserve(std::size_t count) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_index.reserve(count);
+        m_pool.reserve(count);
+    }
+
+    // Reports successful adds/removes to `log` (not owned; nullptr to detach).
+    void setMutationLog(MutationLog* log) noexcept { m_log = log; }
 
 private:
-    std::unordered_map<std::int32_t, std::unique_ptr<Student>> m_students;
+    // Indexes a freshly pooled student, releasing it again on a duplicate
+    // id (or email, unless restoring).
+    Student* insert(Pool::Handle handle, bool restoring);
+    // Whether `student`, with normalized email `emailKey`, may be added.
+    // Needs m_writeMutex.
+    AddResult admits(const Student& student, const std::string& emailKey, bool restoring) const;
+    // Adds a pooled, admitted student to the secondary indexes. Needs both
+    // locks.
+    void indexStudent(const Student& student, Pool::Handle handle, std::string emailKey);
+    Student* findLocked(std::int32_t id, Pool::Handle& handle) const;
+    // Stops `handle` owning normalized email `key`; if it was the indexed
+    // owner, the next restored owner is indexed instead. Needs both locks.
+    void unindexEmail(const std::string& key, Pool::Handle handle);
+
+    // Destroys removed students that no reader can still be looking at.
+    void reclaimRemoved();
+
+    Pool m_pool;
+    ConcurrentIdMap m_index;                               // id -> handle
+    std::vector<std::pair<std::uint64_t, Pool::Handle>> m_retired;   // (epoch stamp, removed handle)
+    mutable std::mutex m_writeMutex;                       // serializes pool and index writers
+
+    // Secondary indexes; written under m_writeMutex and m_searchMutex.
+    IdIndex m_byId;                                             // id order, for paging
+    std::unordered_map<std::string, Pool::Handle> m_byEmail;   // normalized email -> handle
+    // Restored students whose email was already indexed, in load order.
+    std::unordered_map<std::string, std::vector<Pool::Handle>> m_duplicateEmails;
+    PrefixIndex m_byName;                                       // name words -> handle
+    mutable std::shared_mutex m_searchMutex;
+    VersionCounter m_version;
+    MutationLog* m_log = nullptr;
 }; 
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Change counter that lets a reader validate a multi-step read instead of
+// locking, in the manner of a sequence lock. Writers wrap every change in a
+// VersionCounter::Change; unlike a classic seqlock, changes may overlap
+// (EnrollmentManager changes different courses in parallel).
+//
+// read() returns how many changes have completed, or kChanging while any
+// change is under way. If two readings are equal and not kChanging, no
+// change was in progress at the first or started before the second, so
+// everything read in between came from one state of the data.
+class VersionCounter final {
+public:
+    static constexpr std::uint64_t kChanging = UINT64_MAX;
+
+    class Change {
+    public:
+        explicit Change(VersionCounter& counter) noexcept : m_counter(counter) {
+            m_counter.m_started.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~Change() { m_counter.m_finished.fetch_add(1, std::memory_order_seq_cst); }
+
+        Change(const Change&) = delete;
+        Change& operator=(const Change&) = delete;
+
+    private:
+        VersionCounter& m_counter;
+    };
+
+    std::uint64_t read() const noexcept {
+        // Finished first: it never exceeds started, so if started then
+        // matches it, no change was open when started was read.
+        const std::uint64_t finished = m_finished.load(std::memory_order_seq_cst);
+        const std::uint64_t started = m_started.load(std::memory_order_seq_cst);
+        return finished == started ? started : kChanging;
+    }
+
+private:
+    std::atomic<std::uint64_t> m_started{0};
+    std::atomic<std::uint64_t> m_finished{0};
+};
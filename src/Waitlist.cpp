@@ -0,0 +1,96 @@
+#include "Waitlist.h"
+
+bool Waitlist::push(std::int32_t studentId) {
+    if (studentId == kTombstone) {
+        return false;
+    }
+
+    auto [it, inserted] = m_slotOf.emplace(studentId, m_entries.size());
+    if (!inserted) {
+        return false;
+    }
+
+    m_entries.push_back(studentId);
+
+    // Append to the Fenwick tree: node i covers (i - lowbit(i), i], so its
+    // value is this entry's flag plus the live count of the rest of that range.
+    const std::size_t i = m_entries.size();
+    const std::size_t lowbit = i & (~i + 1);
+    const std::size_t below = i - 1 == 0 ? 0 : liveUpTo(i - 2);
+    const std::size_t rangeStart = i - lowbit == 0 ? 0 : liveUpTo(i - lowbit - 1);
+    m_fenwick.push_back(static_cast<std::int32_t>(1 + below - rangeStart));
+    return true;
+}
+
+std::optional<std::int32_t> Waitlist::pop() {
+    while (m_head < m_entries.size() && m_entries[m_head] == kTombstone) {
+        ++m_head;
+    }
+    if (m_head == m_entries.size()) {
+        return std::nullopt;
+    }
+
+    const std::int32_t studentId = m_entries[m_head];
+    m_slotOf.erase(studentId);
+    kill(m_head);
+    ++m_head;
+    compactIfSparse();
+    return studentId;
+}
+
+bool Waitlist::remove(std::int32_t studentId) {
+    auto it = m_slotOf.find(studentId);
+    if (it == m_slotOf.end()) {
+        return false;
+    }
+
+    const std::size_t slot = it->second;
+    m_slotOf.erase(it);
+    kill(slot);
+    compactIfSparse();
+    return true;
+}
+
+std::size_t Waitlist::position(std::int32_t studentId) const {
+    auto it = m_slotOf.find(studentId);
+    return it == m_slotOf.end() ? 0 : liveUpTo(it->second);
+}
+
+void Waitlist::kill(std::size_t slot) {
+    m_entries[slot] = kTombstone;
+    for (std::size_t i = slot + 1; i <= m_fenwick.size(); i += i & (~i + 1)) {
+        --m_fenwick[i - 1];
+    }
+}
+
+std::size_t Waitlist::liveUpTo(std::size_t slot) const {
+    std::size_t count = 0;
+    for (std::size_t i = slot + 1; i > 0; i -= i & (~i + 1)) {
+        count += static_cast<std::size_t>(m_fenwick[i - 1]);
+    }
+    return count;
+}
+
+void Waitlist::compactIfSparse() {
+    const std::size_t dead = m_entries.size() - m_slotOf.size();
+    if (dead < 64 || dead <= m_slotOf.size()) {
+        return;
+    }
+
+    std::vector<std::int32_t> live;
+    live.reserve(m_slotOf.size());
+    for (std::size_t slot = m_head; slot < m_entries.size(); ++slot) {
+        if (m_entries[slot] != kTombstone) {
+            m_slotOf[m_entries[slot]] = live.size();
+            live.push_back(m_entries[slot]);
+        }
+    }
+
+    // Every remaining entry is live, so node i covers exactly lowbit(i) of them.
+    m_fenwick.resize(live.size());
+    for (std::size_t i = 1; i <= live.size(); ++i) {
+        m_fenwick[i - 1] = static_cast<std::int32_t>(i & (~i + 1));
+    }
+    m_entries = std::move(live);
+    m_head = 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// FIFO waitlist for a single course.
+//
+// Entries are appended to a vector and never shifted: popping or removing a
+// student leaves a tombstone that is skipped during iteration. A Fenwick tree
+// over the live flags answers "how many live entries precede this one" in
+// O(log n), and a hash map from studentId to slot gives O(1) membership.
+// Tombstones are compacted away once they outnumber live entries, so removal
+// is amortized O(log n) and memory stays proportional to the live size.
+class Waitlist final {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::int32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::int32_t*;
+        using reference = const std::int32_t&;
+
+        const_iterator() = default;
+        reference operator*() const noexcept { return *m_pos; }
+        const_iterator& operator++() noexcept { ++m_pos; skipDead(); return *this; }
+        const_iterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+        bool operator==(const const_iterator& other) const noexcept { return m_pos == other.m_pos; }
+        bool operator!=(const const_iterator& other) const noexcept { return m_pos != other.m_pos; }
+
+    private:
+        friend class Waitlist;
+        const_iterator(const std::int32_t* pos, const std::int32_t* end) noexcept
+            : m_pos(pos), m_end(end) { skipDead(); }
+        void skipDead() noexcept { while (m_pos != m_end && *m_pos == kTombstone) ++m_pos; }
+
+        const std::int32_t* m_pos = nullptr;
+        const std::int32_t* m_end = nullptr;
+    };
+
+    // Appends a student. Returns false if they are already waiting.
+    bool push(std::int32_t studentId);
+
+    // Removes and returns the student at the front, if any.
+    std::optional<std::int32_t> pop();
+
+    // Removes a student from anywhere in the list. Returns false if not present.
+    bool remove(std::int32_t studentId);
+
+    bool contains(std::int32_t studentId) const { return m_slotOf.count(studentId) != 0; }
+
+    // 1-based position in line, 0 if not present.
+    std::size_t position(std::int32_t studentId) const;
+
+    std::size_t size() const noexcept { return m_slotOf.size(); }
+    bool empty() const noexcept { return m_slotOf.empty(); }
+
+    // Iterates live entries front to back without copying.
+    const_iterator begin() const noexcept { return {m_entries.data() + m_head, m_entries.data() + m_entries.size()}; }
+    const_iterator end() const noexcept { return {m_entries.data() + m_entries.size(), m_entries.data() + m_entries.size()}; }
+
+private:
+    static constexpr std::int32_t kTombstone = INT32_MIN;
+
+    std::vector<std::int32_t> m_entries;                  // studentIds in arrival order, kTombstone when gone
+    std::vector<std::int32_t> m_fenwick;                  // 1-based Fenwick tree over live flags of m_entries
+    std::unordered_map<std::int32_t, std::size_t> m_slotOf;  // studentId -> index into m_entries
+    std::size_t m_head = 0;                               // first slot that may still be live
+
+    void kill(std::size_t slot);
+    std::size_t liveUpTo(std::size_t slot) const;         // live entries in [0, slot]
+    void compactIfSparse();
+};
@@ -1,121 +1,130 @@
 #include "WaitlistManager.h"
-#include <algorithm>
 
 bool WaitlistManager::addToWaitlist(std::int32_t courseId, std::int32_t studentId) {
-    // Check if student is already on this waitlist
-    if (isOnWaitlist(courseId, studentId)) {
+    SES_TIME_OPERATION(WaitlistAdd);
+    Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    Waitlist& waitlist = stripe.waitlists[courseId];
+    if (waitlist.contains(studentId)) {
         return false;
     }
-    
-    m_waitlists[courseId].push(studentId);
+    {
+        VersionCounter::Change change(m_version);
+        waitlist.push(studentId);
+        if (m_aggregates) {
+            m_aggregates->waitlistChanged(courseId, 1);
+        }
+    }
+    if (m_log) {
+        m_log->waitlistAdded(courseId, studentId);
+    }
     return true;
 }
 
 std::int32_t WaitlistManager::getNextFromWaitlist(std::int32_t courseId) {
-    auto it = m_waitlists.find(courseId);
-    if (it == m_waitlists.end() || it->second.empty()) {
+    SES_TIME_OPERATION(WaitlistNext);
+    Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    if (it == stripe.waitlists.end() || it->second.empty()) {
         return -1; // No students on waitlist
     }
-    
-    std::int32_t studentId = it->second.front();
-    it->second.pop();
-    
-    // Clean up empty waitlists
-    if (it->second.empty()) {
-        m_waitlists.erase(it);
+
+    std::int32_t studentId;
+    {
+        VersionCounter::Change change(m_version);
+        studentId = *it->second.pop();
+
+        // Clean up empty waitlists
+        if (it->second.empty()) {
+            stripe.waitlists.erase(it);
+        }
+        if (m_aggregates) {
+            m_aggregates->waitlistChanged(courseId, -1);
+        }
+    }
+    if (m_log) {
+        m_log->waitlistPopped(courseId);
     }
-    
     return studentId;
 }
 
 bool WaitlistManager::isOnWaitlist(std::int32_t courseId, std::int32_t studentId) const {
-    auto it = m_waitlists.find(courseId);
-    if (it == m_waitlists.end()) {
-        return false;
-    }
-    
-    // Need to check if studentId is in the queue
-    // Since std::queue doesn't provide iteration, we'll use a temporary copy
-    std::queue<std::int32_t> temp = it->second;
-    while (!temp.empty()) {
-        if (temp.front() == studentId) {
-            return true;
-        }
-        temp.pop();
-    }
-    return false;
+    SES_TIME_OPERATION(WaitlistContains);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    return it != stripe.waitlists.end() && it->second.contains(studentId);
 }
 
 bool WaitlistManager::removeFromWaitlist(std::int32_t courseId, std::int32_t studentId) {
-    auto it = m_waitlists.find(courseId);
-    if (it == m_waitlists.end()) {
+    SES_TIME_OPERATION(WaitlistRemove);
+    Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    if (it == stripe.waitlists.end() || !it->second.contains(studentId)) {
         return false;
     }
-    
-    // Rebuild queue without the target student
-    std::queue<std::int32_t> newQueue;
-    bool found = false;
-    
-    while (!it->second.empty()) {
-        std::int32_t current = it->second.front();
-        it->second.pop();
-        
-        if (current == studentId && !found) {
-            found = true; // Skip this student (remove them)
-        } else {
-            newQueue.push(current);
+
+    {
+        VersionCounter::Change change(m_version);
+        it->second.remove(studentId);
+        if (it->second.empty()) {
+            stripe.waitlists.erase(it);
+        }
+        if (m_aggregates) {
+            m_aggregates->waitlistChanged(courseId, -1);
         }
     }
-    
-    if (newQueue.empty()) {
-        m_waitlists.erase(it);
-    } else {
-        it->second = std::move(newQueue);
+    if (m_log) {
+        m_log->waitlistRemoved(courseId, studentId);
     }
-    
-    return found;
+    return true;
 }
 
 std::vector<std::int32_t> WaitlistManager::getWaitlist(std::int32_t courseId) const {
-    std::vector<std::int32_t> result;
-    auto it = m_waitlists.find(courseId);
-    if (it == m_waitlists.end()) {
-        return result;
-    }
-    
-    std::queue<std::int32_t> temp = it->second;
-    while (!temp.empty()) {
-        result.push_back(temp.front());
-        temp.pop();
+    SES_TIME_OPERATION(WaitlistGet);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    if (it == stripe.waitlists.end()) {
+        return {};
     }
+
+    std::vector<std::int32_t> result;
+    result.reserve(it->second.size());
+    result.assign(it->second.begin(), it->second.end());
     return result;
 }
 
+const Waitlist* WaitlistManager::findWaitlist(std::int32_t courseId) const {
+    SES_TIME_OPERATION(WaitlistFind);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    return it == stripe.waitlists.end() ? nullptr : &it->second;
+}
+
 std::size_t WaitlistManager::getWaitlistPosition(std::int32_t courseId, std::int32_t studentId) const {
-    auto it = m_waitlists.find(courseId);
-    if (it == m_waitlists.end()) {
-        return 0;
-    }
-    
-    std::queue<std::int32_t> temp = it->second;
-    std::size_t position = 1;
-    
-    while (!temp.empty()) {
-        if (temp.front() == studentId) {
-            return position;
-        }
-        temp.pop();
-        ++position;
-    }
-    return 0; // Not found
+    SES_TIME_OPERATION(WaitlistPosition);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    return it == stripe.waitlists.end() ? 0 : it->second.position(studentId);
 }
 
 bool WaitlistManager::isWaitlistEmpty(std::int32_t courseId) const {
-    auto it = m_waitlists.find(courseId);
-    return it == m_waitlists.end() || it->second.empty();
+    SES_TIME_OPERATION(WaitlistEmpty);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    return it == stripe.waitlists.end() || it->second.empty();
 }
 
 std::size_t WaitlistManager::getWaitlistSize(std::int32_t courseId) const {
-    auto it = m_waitlists.find(courseId);
-    return it == m_waitlists.end() ? 0 : it->second.size();
-} 
\ No newline at end of file
+    SES_TIME_OPERATION(WaitlistSize);
+    const Stripe& stripe = stripeFor(courseId);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.waitlists.find(courseId);
+    return it == stripe.waitlists.end() ? 0 : it->second.size();
+}
@@ -1,11 +1,21 @@
 #pragma once
 
-#include <queue>
 #include <unordered_map>
+#include <array>
 #include <cstdint>
+#include <mutex>
 #include <vector>
+#include "Waitlist.h"
+#include "Metrics.h"
+#include "MutationLog.h"
+#include "ReportAggregates.h"
+#include "VersionCounter.h"
 
-// Manages waitlists for courses that are full
+// Manages waitlists for courses that are full.
+// Waitlists are spread over lock stripes keyed by course id, so every
+// member function is thread-safe and calls for different courses rarely
+// contend. findWaitlist() hands out an unguarded pointer and is meant for
+// single-threaded callers such as the UI.
 class WaitlistManager {
 public:
     // Add student to course waitlist
@@ -22,6 +32,9 @@ public:
     
     // Get all students on a course's waitlist
     std::vector<std::int32_t> getWaitlist(std::int32_t courseId) const;
+
+    // Zero-copy access to a course's waitlist for iteration, nullptr if empty
+    const Waitlist* findWaitlist(std::int32_t courseId) const;
     
     // Get waitlist position (1-based, 0 if not on waitlist)
     std::size_t getWaitlistPosition(std::int32_t courseId, std::int32_t studentId) const;
@@ -32,7 +45,47 @@ public:
     // Get waitlist size
     std::size_t getWaitlistSize(std::int32_t courseId) const;
 
+    // Number of adds, pops and removals made, or VersionCounter::kChanging
+    // while one is under way; two equal readings mean no waitlist changed
+    // in between. See VersionCounter.
+    std::uint64_t version() const noexcept { return m_version.read(); }
+
+    // Reports successful adds, pops and removals to `log` (not owned; nullptr to detach)
+    void setMutationLog(MutationLog* log) noexcept { m_log = log; }
+
+    // Keeps waitlist depths in `aggregates` current (not owned; nullptr to detach)
+    void setAggregates(ReportAggregates* aggregates) noexcept { m_aggregates = aggregates; }
+
+    // Calls fn(courseId, const Waitlist&) for every non-empty waitlist,
+    // holding each stripe's lock while its waitlists are visited
+    template <typename Fn>
+    void forEachWaitlist(Fn&& fn) const {
+        for (const Stripe& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            for (const auto& [courseId, waitlist] : stripe.waitlists) {
+                fn(courseId, waitlist);
+            }
+        }
+    }
+
 private:
-    // Map from courseId to queue of studentIds
-    std::unordered_map<std::int32_t, std::queue<std::int32_t>> m_waitlists;
+    static constexpr std::size_t kStripes = 64;
+
+    struct alignas(64) Stripe {
+        mutable std::mutex mutex;
+        // Map from courseId to that course's waitlist
+        std::unordered_map<std::int32_t, Waitlist> waitlists;
+    };
+
+    Stripe& stripeFor(std::int32_t courseId) noexcept {
+        return m_stripes[static_cast<std::uint32_t>(courseId) % kStripes];
+    }
+    const Stripe& stripeFor(std::int32_t courseId) const noexcept {
+        return m_stripes[static_cast<std::uint32_t>(courseId) % kStripes];
+    }
+
+    std::array<Stripe, kStripes> m_stripes;
+    MutationLog* m_log = nullptr;
+    ReportAggregates* m_aggregates = nullptr;
+    VersionCounter m_version;
 }; 
\ No newline at end of file
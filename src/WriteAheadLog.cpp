@@ -0,0 +1,546 @@
+#include "WriteAheadLog.h"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include "FileUtil.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'E', 'W', 'A', 'L', '\0', '\0', '\x01'};
+constexpr std::size_t kRecordPrefix = sizeof(std::uint32_t) * 2;            // length + crc
+constexpr std::size_t kRecordFixed = sizeof(std::uint64_t) + 1;              // sequence + type
+
+enum class RecordType : std::uint8_t {
+    AddStudent = 1,
+    RemoveStudent,
+    AddCourse,
+    RemoveCourse,
+    AddEnrollment,
+    SetEnrollmentStatus,
+    WaitlistAdd,
+    WaitlistPop,
+    WaitlistRemove,
+    SetCoursePrerequisites,
+    UpdateStudent,
+    UpdateCourse,
+    SetCourseCapacity
+};
+
+const std::array<std::uint32_t, 256>& crcTable() {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+std::uint32_t crc32(const unsigned char* data, std::size_t size) {
+    const auto& table = crcTable();
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+        c = table[(c ^ data[i]) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void putRaw(std::vector<unsigned char>& out, T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds-checked reader over one record's payload.
+class Decoder {
+public:
+    Decoder(const unsigned char* data, std::size_t size) : m_pos(data), m_end(data + size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (static_cast<std::size_t>(m_end - m_pos) < sizeof(T)) return false;
+        std::memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool get(std::string& value) {
+        std::uint32_t length = 0;
+        if (!get(length) || static_cast<std::size_t>(m_end - m_pos) < length) return false;
+        value.assign(reinterpret_cast<const char*>(m_pos), length);
+        m_pos += length;
+        return true;
+    }
+
+private:
+    const unsigned char* m_pos;
+    const unsigned char* m_end;
+};
+
+bool applyRecord(RecordType type, Decoder& in,
+                 StudentRegistry& students, CourseRegistry& courses,
+                 EnrollmentManager& enrollments, WaitlistManager& waitlists) {
+    std::int32_t a = 0, b = 0;
+    switch (type) {
+        case RecordType::AddStudent: {
+            std::string name, email, phone, address, password;
+            if (!in.get(a) || !in.get(name) || !in.get(email) || !in.get(phone) ||
+                !in.get(address) || !in.get(password)) return false;
+            students.restoreStudent(a, std::move(name), std::move(email), std::move(phone),
+                                    std::move(address), std::move(password));
+            return true;
+        }
+        case RecordType::UpdateStudent: {
+            std::string name, email;
+            if (!in.get(a) || !in.get(name) || !in.get(email)) return false;
+            students.setName(a, std::move(name));
+            students.setEmail(a, std::move(email));
+            return true;
+        }
+        case RecordType::RemoveStudent:
+            if (!in.get(a)) return false;
+            students.removeStudent(a);
+            return true;
+        case RecordType::AddCourse: {
+            std::uint8_t credits = 0;
+            std::string name, instructor;
+            std::uint32_t count = 0;
+            if (!in.get(a) || !in.get(credits) || !in.get(name) || !in.get(instructor) || !in.get(count)) return false;
+            std::vector<std::int32_t> prerequisites;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                if (!in.get(b)) return false;
+                prerequisites.push_back(b);
+            }
+            std::uint16_t capacity = 0;
+            if (!in.get(capacity)) return false;
+            courses.restoreCourse(a, std::move(name), credits, std::move(instructor), std::move(prerequisites), capacity);
+            return true;
+        }
+        case RecordType::RemoveCourse:
+            if (!in.get(a)) return false;
+            courses.removeCourse(a);
+            return true;
+        case RecordType::UpdateCourse: {
+            std::uint8_t credits = 0;
+            std::string name, instructor;
+            if (!in.get(a) || !in.get(credits) || !in.get(name) || !in.get(instructor)) return false;
+            courses.setName(a, std::move(name));
+            courses.setCredits(a, credits);
+            courses.setInstructor(a, std::move(instructor));
+            return true;
+        }
+        case RecordType::SetCourseCapacity: {
+            std::uint16_t capacity = 0;
+            if (!in.get(a) || !in.get(capacity)) return false;
+            // The seats it freed were filled by records that follow this one.
+            if (Course* course = courses.findCourse(a)) course->setCapacity(capacity);
+            return true;
+        }
+        case RecordType::SetCoursePrerequisites: {
+            std::uint32_t count = 0;
+            if (!in.get(a) || !in.get(count)) return false;
+            std::vector<std::int32_t> prerequisites;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                if (!in.get(b)) return false;
+                prerequisites.push_back(b);
+            }
+            courses.setPrerequisites(a, std::move(prerequisites));
+            return true;
+        }
+        case RecordType::AddEnrollment: {
+            std::uint8_t status = 0;
+            std::int64_t enrolledAtNs = 0;
+            if (!in.get(a) || !in.get(b) || !in.get(status) || !in.get(enrolledAtNs) ||
+                status > static_cast<std::uint8_t>(Enrollment::Status::Withdrawn)) return false;
+            const std::chrono::system_clock::time_point date(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(enrolledAtNs)));
+            enrollments.restoreEnrollment(Enrollment(a, b, static_cast<Enrollment::Status>(status), date));
+            return true;
+        }
+        case RecordType::SetEnrollmentStatus: {
+            std::uint8_t status = 0;
+            if (!in.get(a) || !in.get(b) || !in.get(status) ||
+                status > static_cast<std::uint8_t>(Enrollment::Status::Withdrawn)) return false;
+            enrollments.setEnrollmentStatus(a, b, static_cast<Enrollment::Status>(status));
+            return true;
+        }
+        case RecordType::WaitlistAdd:
+            if (!in.get(a) || !in.get(b)) return false;
+            waitlists.addToWaitlist(a, b);
+            return true;
+        case RecordType::WaitlistPop:
+            if (!in.get(a)) return false;
+            waitlists.getNextFromWaitlist(a);
+            return true;
+        case RecordType::WaitlistRemove:
+            if (!in.get(a) || !in.get(b)) return false;
+            waitlists.removeFromWaitlist(a, b);
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// Builds one record's type byte and payload; the sequence number and
+// framing are added by append() under a stripe lock.
+class WriteAheadLog::Encoder {
+public:
+    explicit Encoder(RecordType type) { m_bytes.push_back(static_cast<unsigned char>(type)); }
+
+    template <typename T>
+    Encoder& put(T value) { putRaw(m_bytes, value); return *this; }
+
+    Encoder& put(std::string_view value) {
+        putRaw(m_bytes, static_cast<std::uint32_t>(value.size()));
+        m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+        return *this;
+    }
+    Encoder& put(const std::string& value) { return put(std::string_view(value)); }
+
+    const std::vector<unsigned char>& bytes() const noexcept { return m_bytes; }
+
+private:
+    std::vector<unsigned char> m_bytes;
+};
+
+WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+bool WriteAheadLog::open(const std::string& path, const ReplayResult& recovered, Options options) {
+    close();
+
+    std::error_code ec;
+    const bool keep = recovered.validBytes >= sizeof(kMagic);
+    if (keep) {
+        std::filesystem::resize_file(path, recovered.validBytes, ec);
+        if (ec) return false;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), keep ? "ab" : "wb");
+    if (!file) {
+        return false;
+    }
+    if (!keep && (std::fwrite(kMagic, 1, sizeof(kMagic), file) != sizeof(kMagic) || !syncFile(file))) {
+        std::fclose(file);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file = file;
+    m_path = path;
+    m_options = options;
+    m_nextSequence.store(recovered.lastSequence + 1);
+    m_durableSequence = recovered.lastSequence;
+    for (Stripe& stripe : m_stripes) {
+        stripe.pending.clear();
+    }
+    m_pendingBytes.store(0);
+    m_open.store(true);
+    m_stopping = false;
+    m_failed = false;
+    m_flusher = std::thread(&WriteAheadLog::flusherLoop, this);
+    return true;
+}
+
+void WriteAheadLog::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open.store(false);
+        m_stopping = true;
+    }
+    m_wakeFlusher.notify_one();
+    if (m_flusher.joinable()) m_flusher.join();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool WriteAheadLog::sync() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_file) return false;
+    const std::uint64_t target = m_nextSequence.load() - 1;
+    ++m_syncWaiters;
+    m_wakeFlusher.notify_one();
+    m_durable.wait(lock, [&] { return m_durableSequence >= target || m_failed; });
+    --m_syncWaiters;
+    return !m_failed;
+}
+
+bool WriteAheadLog::reset() {
+    if (!sync()) return false;
+
+    std::lock_guard<std::mutex> io(m_ioMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // The flusher keeps using m_file, so it is only replaced by a file that
+    // actually opened. Once the path is truncated the old handle is useless,
+    // and a failed header write marks the new one failed instead.
+    std::FILE* file = std::fopen(m_path.c_str(), "wb");
+    if (!file) {
+        m_failed = true;
+        return false;
+    }
+    std::fclose(m_file);
+    m_file = file;
+    if (std::fwrite(kMagic, 1, sizeof(kMagic), file) != sizeof(kMagic) || !syncFile(file)) {
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t WriteAheadLog::lastSequence() const {
+    return m_nextSequence.load() - 1;
+}
+
+bool WriteAheadLog::healthy() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file && !m_failed;
+}
+
+void WriteAheadLog::append(const Encoder& record) {
+    static std::atomic<std::size_t> nextStripe{0};
+    thread_local const std::size_t stripeIndex = nextStripe.fetch_add(1, std::memory_order_relaxed) % kStripes;
+
+    const auto& body = record.bytes();
+    Stripe& stripe = m_stripes[stripeIndex];
+    std::uint64_t sequence;
+    std::size_t pendingBytes;
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        if (!m_open.load(std::memory_order_acquire)) return;
+
+        // Taken under the stripe lock, so each stripe stays in sequence
+        // order and takePending() sees every number handed out.
+        sequence = m_nextSequence.fetch_add(1);
+        std::vector<unsigned char>& pending = stripe.pending;
+        const std::size_t start = pending.size();
+        putRaw(pending, static_cast<std::uint32_t>(sizeof(sequence) + body.size()));
+        putRaw(pending, std::uint32_t{0});   // crc, patched below
+        putRaw(pending, sequence);
+        pending.insert(pending.end(), body.begin(), body.end());
+
+        const std::uint32_t crc = crc32(pending.data() + start + kRecordPrefix, pending.size() - start - kRecordPrefix);
+        std::memcpy(pending.data() + start + sizeof(std::uint32_t), &crc, sizeof(crc));
+        pendingBytes = m_pendingBytes.fetch_add(pending.size() - start) + (pending.size() - start);
+    }
+
+    if (m_options.durability == Durability::Synchronous) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_syncWaiters;
+        m_wakeFlusher.notify_one();
+        m_durable.wait(lock, [&] { return m_durableSequence >= sequence || m_failed; });
+        --m_syncWaiters;
+    } else if (pendingBytes >= m_options.flushBytes) {
+        m_wakeFlusher.notify_one();
+    }
+}
+
+std::uint64_t WriteAheadLog::takePending(std::vector<unsigned char>& batch) {
+    std::array<std::unique_lock<std::mutex>, kStripes> locks;
+    for (std::size_t i = 0; i < kStripes; ++i) {
+        locks[i] = std::unique_lock<std::mutex>(m_stripes[i].mutex);
+    }
+    const std::uint64_t last = m_nextSequence.load() - 1;
+
+    // Each stripe is already in order, so a k-way merge on the sequence
+    // number restores the global order.
+    std::array<std::size_t, kStripes> pos{};
+    for (;;) {
+        std::size_t pick = kStripes;
+        std::uint64_t lowest = 0;
+        for (std::size_t i = 0; i < kStripes; ++i) {
+            const std::vector<unsigned char>& pending = m_stripes[i].pending;
+            if (pos[i] == pending.size()) continue;
+            std::uint64_t sequence;
+            std::memcpy(&sequence, pending.data() + pos[i] + kRecordPrefix, sizeof(sequence));
+            if (pick == kStripes || sequence < lowest) {
+                pick = i;
+                lowest = sequence;
+            }
+        }
+        if (pick == kStripes) break;
+        const std::vector<unsigned char>& pending = m_stripes[pick].pending;
+        std::uint32_t length;
+        std::memcpy(&length, pending.data() + pos[pick], sizeof(length));
+        const auto record = pending.begin() + static_cast<std::ptrdiff_t>(pos[pick]);
+        batch.insert(batch.end(), record, record + static_cast<std::ptrdiff_t>(kRecordPrefix + length));
+        pos[pick] += kRecordPrefix + length;
+    }
+    for (Stripe& stripe : m_stripes) {
+        stripe.pending.clear();
+    }
+    m_pendingBytes.store(0);
+    return last;
+}
+
+void WriteAheadLog::flusherLoop() {
+    std::vector<unsigned char> batch;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wakeFlusher.wait_for(lock, m_options.flushInterval, [&] {
+            const std::size_t pending = m_pendingBytes.load();
+            return m_stopping || (pending > 0 && (m_syncWaiters > 0 || pending >= m_options.flushBytes));
+        });
+
+        if (m_pendingBytes.load() == 0) {
+            if (m_stopping) return;
+            continue;
+        }
+
+        // Everything appended so far goes out in one write + fsync; records
+        // appended while we are syncing form the next group.
+        lock.unlock();
+        const std::uint64_t batchEnd = takePending(batch);
+
+        bool ok;
+        {
+            std::lock_guard<std::mutex> io(m_ioMutex);
+            ok = std::fwrite(batch.data(), 1, batch.size(), m_file) == batch.size() && syncFile(m_file);
+        }
+        batch.clear();
+
+        lock.lock();
+        if (ok) {
+            m_durableSequence = batchEnd;
+        } else {
+            m_failed = true;
+        }
+        m_durable.notify_all();
+    }
+}
+
+WriteAheadLog::ReplayResult WriteAheadLog::replay(const std::string& path, std::uint64_t afterSequence,
+                                                  StudentRegistry& students, CourseRegistry& courses,
+                                                  EnrollmentManager& enrollments, WaitlistManager& waitlists) {
+    ReplayResult result;
+    result.lastSequence = afterSequence;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        result.ok = !std::filesystem::exists(path);
+        return result;
+    }
+    if (file.size() == 0) {
+        result.ok = true;
+        return result;
+    }
+    if (file.size() < sizeof(kMagic) || std::memcmp(file.data(), kMagic, sizeof(kMagic)) != 0) {
+        return result;
+    }
+
+    result.ok = true;
+    const unsigned char* data = file.data();
+    std::uint64_t pos = sizeof(kMagic);
+    while (file.size() - pos >= kRecordPrefix) {
+        std::uint32_t length = 0, crc = 0;
+        std::memcpy(&length, data + pos, sizeof(length));
+        std::memcpy(&crc, data + pos + sizeof(length), sizeof(crc));
+        if (length < kRecordFixed || file.size() - pos - kRecordPrefix < length) break;
+
+        const unsigned char* body = data + pos + kRecordPrefix;
+        if (crc32(body, length) != crc) break;
+
+        std::uint64_t sequence = 0;
+        std::memcpy(&sequence, body, sizeof(sequence));
+        const auto type = static_cast<RecordType>(body[sizeof(sequence)]);
+
+        if (sequence > afterSequence) {
+            Decoder in(body + kRecordFixed, length - kRecordFixed);
+            // The record arrived intact, so a failure is not a torn tail:
+            // refuse the log rather than truncate the records after it.
+            if (!applyRecord(type, in, students, courses, enrollments, waitlists)) {
+                result.ok = false;
+                return result;
+            }
+            ++result.applied;
+        }
+        if (sequence > result.lastSequence) result.lastSequence = sequence;
+        pos += kRecordPrefix + length;
+    }
+    result.validBytes = pos;
+    return result;
+}
+
+void WriteAheadLog::studentAdded(const Student& student) {
+    append(Encoder(RecordType::AddStudent)
+               .put(student.id()).put(student.name()).put(student.email())
+               .put(student.phone()).put(student.address()).put(student.password()));
+}
+
+void WriteAheadLog::studentRemoved(std::int32_t studentId) {
+    append(Encoder(RecordType::RemoveStudent).put(studentId));
+}
+
+void WriteAheadLog::studentUpdated(const Student& student) {
+    append(Encoder(RecordType::UpdateStudent).put(student.id()).put(student.name()).put(student.email()));
+}
+
+void WriteAheadLog::courseAdded(const Course& course) {
+    Encoder record(RecordType::AddCourse);
+    record.put(course.id()).put(course.credits()).put(course.name()).put(course.instructor())
+          .put(static_cast<std::uint32_t>(course.prerequisites().size()));
+    for (std::int32_t prereq : course.prerequisites()) {
+        record.put(prereq);
+    }
+    record.put(course.capacity());
+    append(record);
+}
+
+void WriteAheadLog::courseRemoved(std::int32_t courseId) {
+    append(Encoder(RecordType::RemoveCourse).put(courseId));
+}
+
+void WriteAheadLog::coursePrerequisitesChanged(const Course& course) {
+    Encoder record(RecordType::SetCoursePrerequisites);
+    record.put(course.id()).put(static_cast<std::uint32_t>(course.prerequisites().size()));
+    for (std::int32_t prereq : course.prerequisites()) {
+        record.put(prereq);
+    }
+    append(record);
+}
+
+void WriteAheadLog::courseUpdated(const Course& course) {
+    append(Encoder(RecordType::UpdateCourse).put(course.id()).put(course.credits()).put(course.name())
+                                            .put(course.instructor()));
+}
+
+void WriteAheadLog::courseCapacityChanged(std::int32_t courseId, std::uint16_t capacity) {
+    append(Encoder(RecordType::SetCourseCapacity).put(courseId).put(capacity));
+}
+
+void WriteAheadLog::enrollmentAdded(const Enrollment& enrollment) {
+    const std::int64_t enrolledAtNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        enrollment.enrollmentDate().time_since_epoch()).count();
+    append(Encoder(RecordType::AddEnrollment)
+               .put(enrollment.studentId()).put(enrollment.courseId())
+               .put(static_cast<std::uint8_t>(enrollment.status())).put(enrolledAtNs));
+}
+
+void WriteAheadLog::enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status) {
+    append(Encoder(RecordType::SetEnrollmentStatus)
+               .put(studentId).put(courseId).put(static_cast<std::uint8_t>(status)));
+}
+
+void WriteAheadLog::waitlistAdded(std::int32_t courseId, std::int32_t studentId) {
+    append(Encoder(RecordType::WaitlistAdd).put(courseId).put(studentId));
+}
+
+void WriteAheadLog::waitlistPopped(std::int32_t courseId) {
+    append(Encoder(RecordType::WaitlistPop).put(courseId));
+}
+
+void WriteAheadLog::waitlistRemoved(std::int32_t courseId, std::int32_t studentId) {
+    append(Encoder(RecordType::WaitlistRemove).put(courseId).put(studentId));
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MutationLog.h"
+#include "StudentRegistry.h"
+#include "CourseRegistry.h"
+#include "EnrollmentManager.h"
+#include "WaitlistManager.h"
+
+// Append-only, checksummed log of every mutation reported through
+// MutationLog. Records are encoded into an in-memory buffer on the calling
+// thread; a background thread writes and fsyncs whatever has accumulated in
+// one go (group commit), so durability costs one fsync per batch rather
+// than one per enrollment.
+//
+// Appending threads are spread over kStripes buffers, each with its own
+// lock, so threads logging enrollments in different courses do not queue
+// on one mutex. Sequence numbers come from one atomic counter, and the
+// flusher merges the buffers back into sequence order before writing.
+//
+// Record layout: [u32 length][u32 crc32][u64 sequence][u8 type][payload],
+// where length and crc cover everything after the crc field. Replay stops at
+// the first truncated or corrupt record, which is how a torn tail from a
+// crash mid-write is discarded.
+class WriteAheadLog final : public MutationLog {
+public:
+    enum class Durability {
+        Batched,      // mutations return immediately; flushed every flushInterval
+        Synchronous   // mutations wait until the batch containing them is durable
+    };
+
+    struct Options {
+        Durability durability = Durability::Batched;
+        std::chrono::milliseconds flushInterval{5};
+        std::size_t flushBytes = 1 << 20;   // wake the flusher early past this much pending data
+    };
+
+    struct ReplayResult {
+        bool ok = false;                 // false if the file is not a log or holds an unappliable record
+        std::uint64_t lastSequence = 0;  // highest sequence seen (applied or skipped)
+        std::size_t applied = 0;
+        std::uint64_t validBytes = 0;    // length of the intact prefix of the file
+    };
+
+    WriteAheadLog() = default;
+    ~WriteAheadLog() override;
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Opens `path` for appending. `recovered` is the result of replaying the
+    // same file: its intact prefix is kept (dropping any torn tail) and new
+    // records continue after its lastSequence. With a default ReplayResult the
+    // file is created or overwritten.
+    bool open(const std::string& path, const ReplayResult& recovered, Options options);
+    bool open(const std::string& path, const ReplayResult& recovered) { return open(path, recovered, Options{}); }
+
+    // Flushes outstanding records and stops the background thread.
+    void close();
+
+    // Blocks until every record appended so far is on stable storage.
+    bool sync();
+
+    // Discards all records after a checkpoint. Sequence numbers continue.
+    // Call while no other thread is mutating the logged objects.
+    bool reset();
+
+    std::uint64_t lastSequence() const;
+    bool healthy() const;
+
+    // Applies every record with sequence > `afterSequence` from `path`.
+    // A missing file is an empty log. Replay stops at a torn or corrupt
+    // record; an intact record that cannot be applied fails the replay.
+    static ReplayResult replay(const std::string& path, std::uint64_t afterSequence,
+                               StudentRegistry& students, CourseRegistry& courses,
+                               EnrollmentManager& enrollments, WaitlistManager& waitlists);
+
+    // MutationLog
+    void studentAdded(const Student& student) override;
+    void studentRemoved(std::int32_t studentId) override;
+    void studentUpdated(const Student& student) override;
+    void courseAdded(const Course& course) override;
+    void courseRemoved(std::int32_t courseId) override;
+    void coursePrerequisitesChanged(const Course& course) override;
+    void courseUpdated(const Course& course) override;
+    void courseCapacityChanged(std::int32_t courseId, std::uint16_t capacity) override;
+    void enrollmentAdded(const Enrollment& enrollment) override;
+    void enrollmentStatusChanged(std::int32_t studentId, std::int32_t courseId, Enrollment::Status status) override;
+    void waitlistAdded(std::int32_t courseId, std::int32_t studentId) override;
+    void waitlistPopped(std::int32_t courseId) override;
+    void waitlistRemoved(std::int32_t courseId, std::int32_t studentId) override;
+
+private:
+    class Encoder;
+
+    static constexpr std::size_t kStripes = 16;
+
+    // Records appended by the threads assigned to one stripe, in sequence order.
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+        std::vector<unsigned char> pending;
+    };
+
+    void append(const Encoder& record);
+    void flusherLoop();
+    // Moves every stripe's records into `batch`, merged by sequence number.
+    // Returns the last sequence number handed out, all of which are in `batch`.
+    std::uint64_t takePending(std::vector<unsigned char>& batch);
+
+    mutable std::mutex m_mutex;     // guards everything below except file writes and the stripes
+    std::mutex m_ioMutex;           // guards writes to m_file; taken before m_mutex
+    std::condition_variable m_wakeFlusher;
+    std::condition_variable m_durable;
+    std::thread m_flusher;
+
+    std::FILE* m_file = nullptr;
+    std::string m_path;
+    Options m_options;              // written by open() only, so appenders read it unlocked
+    std::array<Stripe, kStripes> m_stripes;
+    std::atomic<bool> m_open{false};
+    std::atomic<std::uint64_t> m_nextSequence{1};   // taken under the stripe lock
+    std::atomic<std::size_t> m_pendingBytes{0};     // changed under a stripe lock
+    std::uint64_t m_durableSequence = 0;
+    std::size_t m_syncWaiters = 0;
+    bool m_stopping = false;
+    bool m_failed = false;
+};
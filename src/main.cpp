@@ -16,7 +16,7 @@ int main() {
     students.addStudent(std::make_unique<Student>(3, "Charlie", "charlie@example.com"));
 
     // Add courses with prerequisites
-    courses.addCourse(std::make_unique<Course>(101, "Math 101", 3, "Prof. Euler"));
+    courses.addCourse(std::make_unique<Course>(101, "Math 101", 3, "Prof. Euler", std::vector<std::int32_t>{}, 2));
     courses.addCourse(std::make_unique<Course>(201, "Math 201", 3, "Prof. Gauss", std::vector<std::int32_t>{101}));
     courses.addCourse(std::make_unique<Course>(301, "Advanced Math", 4, "Prof. Newton", std::vector<std::int32_t>{101, 201}));
 
@@ -25,6 +25,7 @@ int main() {
     // Create enrollment manager
     EnrollmentManager enrollment(students, courses);
     WaitlistManager waitlist;
+    enrollment.setWaitlistManager(&waitlist);
 
     // Test enrollments
     std::cout << "1. Enrolling Alice in Math 101...\n";
@@ -47,20 +48,23 @@ int main() {
     std::cout << "Result: " << (result == EnrollmentManager::EnrollmentResult::Success ? "Success" : "Failed") << "\n\n";
 
     std::cout << "4. Current enrollments:\n";
-    for (const auto* e : enrollment.getAllEnrollments()) {
-        const Student* student = students.findStudent(e->studentId());
-        const Course* course = courses.findCourse(e->courseId());
+    for (const auto& e : enrollment.getAllEnrollments()) {
+        const Student* student = students.findStudent(e.studentId());
+        const Course* course = courses.findCourse(e.courseId());
         std::cout << "  " << student->name() << " enrolled in " << course->name() << "\n";
     }
     std::cout << "\n";
 
-    std::cout << "5. Testing waitlist - adding Charlie to Math 101 waitlist...\n";
-    waitlist.addToWaitlist(101, 3);
+    std::cout << "5. Enrolling Charlie in Math 101 (capacity 2)...\n";
+    result = enrollment.enrollStudent(3, 101);
+    std::cout << "Result: " << (result == EnrollmentManager::EnrollmentResult::CourseFull ? "Course full" : "Unexpected") << "\n";
     std::cout << "Charlie's position in Math 101 waitlist: " << waitlist.getWaitlistPosition(101, 3) << "\n\n";
 
     std::cout << "6. Dropping Alice from Math 101...\n";
     enrollment.dropStudent(1, 101);
-    std::cout << "Next student from waitlist: " << waitlist.getNextFromWaitlist(101) << " (Charlie)\n\n";
+    std::cout << "Charlie promoted from the waitlist: "
+              << (enrollment.getStudentEnrollments(3).empty() ? "No" : "Yes") << "\n";
+    std::cout << "Seats remaining in Math 101: " << enrollment.seatsRemaining(101) << "\n\n";
 
     std::cout << "=== Demo Complete ===\n";
     return 0;
@@ -3,10 +3,19 @@
 #include <memory>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <optional>
 #include "StudentRegistry.h"
 #include "CourseRegistry.h"
 #include "EnrollmentManager.h"
 #include "WaitlistManager.h"
+#include "PersistentStore.h"
+#include "ReportAggregates.h"
+#include "BulkImporter.h"
+#include "DegreePlanner.h"
+
+// Base name of the snapshot (.snap) and write-ahead log (.wal) files
+static const char* const kDataFile = "enrollment_data";
 
 // Simple console-based GUI using text menus
 class ConsoleApp {
@@ -17,9 +26,19 @@ public:
         m_courses = std::make_unique<CourseRegistry>();
         m_enrollmentManager = std::make_unique<EnrollmentManager>(*m_students, *m_courses);
         m_waitlistManager = std::make_unique<WaitlistManager>();
-        
-        // Add sample data
-        initializeSampleData();
+        m_enrollmentManager->setWaitlistManager(m_waitlistManager.get());
+        m_reports = std::make_unique<ReportAggregates>();
+        m_enrollmentManager->setAggregates(m_reports.get());
+        m_waitlistManager->setAggregates(m_reports.get());
+        
+        // Restore the previous session, or start from sample data
+        m_store = std::make_unique<PersistentStore>(*m_students, *m_courses, *m_enrollmentManager, *m_waitlistManager);
+        if (!m_store->open(kDataFile)) {
+            std::cerr << "Running without persistence: " << m_store->lastError() << "\n";
+        }
+        if (!m_store->restoredData()) {
+            initializeSampleData();
+        }
     }
     
     void run() {
@@ -37,7 +56,9 @@ public:
                 case 4: viewReports(); break;
                 case 5: viewWaitlists(); break;
                 case 6: runDemo(); break;
+                case 7: bulkImport(); break;
                 case 0: 
+                    saveData();
                     std::cout << "\nThank you for using the Student Enrollment System!\n";
                     return;
                 default:
@@ -55,6 +76,17 @@ private:
     std::unique_ptr<CourseRegistry> m_courses;
     std::unique_ptr<EnrollmentManager> m_enrollmentManager;
     std::unique_ptr<WaitlistManager> m_waitlistManager;
+    std::unique_ptr<ReportAggregates> m_reports;
+    std::unique_ptr<PersistentStore> m_store;
+    
+    // Rows per page in the list views
+    static constexpr std::size_t kPageSize = 20;
+    
+    void saveData() {
+        if (!m_store->checkpoint() && !m_store->lastError().empty()) {
+            std::cerr << "Failed to save data: " << m_store->lastError() << "\n";
+        }
+    }
     
     void initializeSampleData() {
         // Add sample students
@@ -80,6 +112,7 @@ private:
         std::cout << "4. View Reports\n";
         std::cout << "5. View Waitlists\n";
         std::cout << "6. Run Demo\n";
+        std::cout << "7. Bulk Import (CSV/TSV)\n";
         std::cout << "0. Exit\n";
         std::cout << std::string(50, '=') << "\n";
         std::cout << "Enter your choice: ";
@@ -125,6 +158,8 @@ private:
             std::cout << "2. Add Course\n";
             std::cout << "3. Remove Course\n";
             std::cout << "4. Find Course\n";
+            std::cout << "5. Filter Courses\n";
+            std::cout << "6. Change Capacity\n";
             std::cout << "0. Back to Main Menu\n";
             std::cout << "Choice: ";
             
@@ -134,6 +169,8 @@ private:
                 case 2: addCourse(); break;
                 case 3: removeCourse(); break;
                 case 4: findCourse(); break;
+                case 5: filterCourses(); break;
+                case 6: changeCapacity(); break;
                 case 0: return;
                 default: std::cout << "Invalid choice.\n";
             }
@@ -147,6 +184,8 @@ private:
             std::cout << "2. Enroll Student\n";
             std::cout << "3. Drop Student\n";
             std::cout << "4. Check Prerequisites\n";
+            std::cout << "5. Mark Enrollment Completed\n";
+            std::cout << "6. Plan Path to Courses\n";
             std::cout << "0. Back to Main Menu\n";
             std::cout << "Choice: ";
             
@@ -156,6 +195,8 @@ private:
                 case 2: enrollStudent(); break;
                 case 3: dropStudent(); break;
                 case 4: checkPrerequisites(); break;
+                case 5: completeEnrollment(); break;
+                case 6: planPath(); break;
                 case 0: return;
                 default: std::cout << "Invalid choice.\n";
             }
@@ -168,12 +209,34 @@ private:
         std::cout << "ID    Name                Email                     Phone        \n";
         std::cout << std::string(80, '-') << "\n";
         
-        for (const Student* student : m_students->allStudents()) {
-            std::cout << std::left 
-                      << std::setw(6) << student->id()
-                      << std::setw(20) << student->name()
-                      << std::setw(26) << student->email()
-                      << student->phone() << "\n";
+        std::optional<std::int32_t> after;   // last id shown
+        paginate([&] {
+            std::size_t shown = 0;
+            for (const Student& student : after ? m_students->page(*after, kPageSize)
+                                                : m_students->firstPage(kPageSize)) {
+                std::cout << std::left 
+                          << std::setw(6) << student.id()
+                          << std::setw(20) << student.name()
+                          << std::setw(26) << student.email()
+                          << student.phone() << "\n";
+                after = student.id();
+                ++shown;
+            }
+            return shown;
+        });
+    }
+    
+    // Calls printPage() for successive pages until one comes back short or
+    // the user stops; printPage returns the number of rows it printed.
+    template <typename PrintPage>
+    void paginate(PrintPage printPage) {
+        while (printPage() == kPageSize) {
+            std::cout << "-- Enter for more, q to stop: ";
+            std::string answer;
+            std::getline(std::cin, answer);
+            if (!answer.empty() && (answer[0] == 'q' || answer[0] == 'Q')) {
+                break;
+            }
         }
     }
     
@@ -202,7 +265,7 @@ private:
         if (m_students->addStudent(std::move(student))) {
             std::cout << "Student added successfully!\n";
         } else {
-            std::cout << "Failed to add student (ID may already exist).\n";
+            std::cout << "Failed to add student (ID or email may already exist).\n";
         }
     }
     
@@ -221,11 +284,28 @@ private:
     
     void findStudent() {
         std::cout << "\n--- Find Student ---\n";
-        int id;
-        std::cout << "Enter Student ID: ";
-        std::cin >> id;
-        
-        const Student* student = m_students->findStudent(id);
+        std::string query;
+        std::cout << "Enter Student ID, email or name: ";
+        std::cin >> std::ws;
+        std::getline(std::cin, query);
+        
+        const Student* student = nullptr;
+        if (!query.empty() && query.size() <= 9 && query.find_first_not_of("0123456789") == std::string::npos) {
+            student = m_students->findStudent(std::stoi(query));
+        } else if (query.find('@') != std::string::npos) {
+            student = m_students->findStudentByEmail(query);
+        } else {
+            const auto matches = m_students->searchStudentsByName(query, 20);
+            if (matches.size() > 1) {
+                std::cout << "\nMatching students:\n";
+                for (const Student* match : matches) {
+                    std::cout << std::left << std::setw(6) << match->id()
+                              << std::setw(20) << match->name() << match->email() << "\n";
+                }
+                return;
+            }
+            student = matches.empty() ? nullptr : matches.front();
+        }
         if (student) {
             std::cout << "\nStudent Found:\n";
             std::cout << "ID: " << student->id() << "\n";
@@ -240,31 +320,105 @@ private:
     
     void viewAllCourses() {
         std::cout << "\n--- All Courses ---\n";
+        printCourseHeader();
+        
+        std::optional<std::int32_t> after;   // last id shown
+        paginate([&] {
+            std::size_t shown = 0;
+            for (const Course& course : after ? m_courses->page(*after, kPageSize)
+                                              : m_courses->firstPage(kPageSize)) {
+                printCourseRow(course);
+                after = course.id();
+                ++shown;
+            }
+            return shown;
+        });
+    }
+    
+    void filterCourses() {
+        std::cout << "\n--- Filter Courses ---\n";
+        std::string name, instructor;
+        int minCredits = 0, maxCredits = 255;
+        
+        std::cout << "Name words (blank for any): ";
+        std::getline(std::cin, name);
+        std::cout << "Instructor (blank for any): ";
+        std::getline(std::cin, instructor);
+        std::cout << "Minimum credits: ";
+        std::cin >> minCredits;
+        std::cout << "Maximum credits: ";
+        std::cin >> maxCredits;
+        
+        instructor = PrefixIndex::normalizeKey(instructor);
+        const auto minValue = static_cast<std::uint8_t>(std::clamp(minCredits, 0, 255));
+        const auto maxValue = static_cast<std::uint8_t>(std::clamp(maxCredits, 0, 255));
+        std::size_t shown = 0;
+        
+        // Instructors compare by interned key; a name never interned matches no course.
+        StringPool::Id instructorKey = StringPool::kEmpty;
+        const bool instructorKnown = StringPool::instructors().find(instructor, instructorKey);
+        
+        printCourseHeader();
+        // Scan the narrowest index and check the remaining conditions per course.
+        auto show = [&](const Course& course) {
+            if ((!instructor.empty() && (!instructorKnown || course.instructorKey() != instructorKey)) ||
+                course.credits() < minValue || course.credits() > maxValue) {
+                return;
+            }
+            printCourseRow(course);
+            ++shown;
+        };
+        if (name.find_first_not_of(" \t") != std::string::npos) {
+            for (const Course* course : m_courses->searchCoursesByName(name)) show(*course);
+        } else if (!instructor.empty()) {
+            if (instructorKnown) {
+                for (const Course& course : m_courses->coursesByInstructor(instructorKey)) show(course);
+            }
+        } else {
+            for (const Course& course : m_courses->coursesByCredits(minValue, maxValue)) show(course);
+        }
+        std::cout << shown << " course(s).\n";
+    }
+    
+    void printCourseHeader() const {
         std::cout << std::string(80, '-') << "\n";
-        std::cout << "ID    Name                     Credits  Instructor\n";
+        std::cout << "ID    Name                     Credits  Seats    Instructor\n";
         std::cout << std::string(80, '-') << "\n";
-        
-        for (const Course* course : m_courses->allCourses()) {
-            std::cout << std::left 
-                      << std::setw(6) << course->id()
-                      << std::setw(25) << course->name()
-                      << std::setw(9) << static_cast<int>(course->credits())
-                      << course->instructor() << "\n";
-            
-            if (!course->prerequisites().empty()) {
-                std::cout << "      Prerequisites: ";
-                for (size_t i = 0; i < course->prerequisites().size(); ++i) {
-                    if (i > 0) std::cout << ", ";
-                    std::cout << course->prerequisites()[i];
-                }
-                std::cout << "\n";
+    }
+    
+    void printCourseRow(const Course& course) const {
+        std::cout << std::left 
+                  << std::setw(6) << course.id()
+                  << std::setw(25) << course.name()
+                  << std::setw(9) << static_cast<int>(course.credits())
+                  << std::setw(9) << seatsLabel(course)
+                  << course.instructor() << "\n";
+        
+        if (!course.prerequisites().empty()) {
+            std::cout << "      Prerequisites: ";
+            for (size_t i = 0; i < course.prerequisites().size(); ++i) {
+                if (i > 0) std::cout << ", ";
+                std::cout << course.prerequisites()[i];
             }
+            std::cout << "\n";
         }
     }
     
+    // "taken/capacity", or "taken/-" when the course has no seat limit
+    std::string seatsLabel(const Course& course) const {
+        std::string label = std::to_string(m_enrollmentManager->activeEnrollmentCount(course.id())) + "/";
+        return label + (course.hasCapacityLimit() ? std::to_string(course.capacity()) : "-");
+    }
+    
+    // Negative input means no seat limit
+    static std::uint16_t capacityFromInput(int capacity) {
+        if (capacity < 0) return Course::kUnlimitedCapacity;
+        return static_cast<std::uint16_t>(std::min<int>(capacity, Course::kUnlimitedCapacity - 1));
+    }
+    
     void addCourse() {
         std::cout << "\n--- Add New Course ---\n";
-        int id, credits;
+        int id, credits, capacity;
         std::string name, instructor, prereqStr;
         
         std::cout << "Course ID: ";
@@ -284,6 +438,9 @@ private:
         std::cout << "Prerequisites (comma-separated IDs, or press Enter for none): ";
         std::getline(std::cin, prereqStr);
         
+        std::cout << "Capacity (-1 for unlimited, 0 for closed): ";
+        std::cin >> capacity;
+        
         // Parse prerequisites
         std::vector<std::int32_t> prerequisites;
         if (!prereqStr.empty()) {
@@ -299,11 +456,22 @@ private:
             }
         }
         
-        auto course = std::make_unique<Course>(id, name, static_cast<std::uint8_t>(credits), instructor, prerequisites);
+        auto course = std::make_unique<Course>(id, name, static_cast<std::uint8_t>(credits), instructor, prerequisites,
+                                               capacityFromInput(capacity));
         if (m_courses->addCourse(std::move(course))) {
             std::cout << "Course added successfully!\n";
         } else {
-            std::cout << "Failed to add course (ID may already exist).\n";
+            switch (m_courses->checkPrerequisites(id, prerequisites)) {
+                case PrerequisiteGraph::Result::UnknownPrerequisite:
+                    std::cout << "Failed to add course: a prerequisite is not a registered course.\n";
+                    break;
+                case PrerequisiteGraph::Result::Cycle:
+                    std::cout << "Failed to add course: the prerequisites would form a cycle.\n";
+                    break;
+                default:
+                    std::cout << "Failed to add course (ID may already exist).\n";
+                    break;
+            }
         }
     }
     
@@ -320,6 +488,24 @@ private:
         }
     }
     
+    void changeCapacity() {
+        std::cout << "\n--- Change Course Capacity ---\n";
+        int id, capacity;
+        std::cout << "Enter Course ID: ";
+        std::cin >> id;
+        std::cout << "New capacity (-1 for unlimited, 0 for closed): ";
+        std::cin >> capacity;
+        
+        const std::size_t before = m_enrollmentManager->activeEnrollmentCount(id);
+        if (m_enrollmentManager->setCapacity(id, capacityFromInput(capacity))) {
+            std::cout << "Capacity updated. "
+                      << m_enrollmentManager->activeEnrollmentCount(id) - before
+                      << " student(s) promoted from the waitlist.\n";
+        } else {
+            std::cout << "Course not found.\n";
+        }
+    }
+    
     void findCourse() {
         std::cout << "\n--- Find Course ---\n";
         int id;
@@ -333,6 +519,7 @@ private:
             std::cout << "Name: " << course->name() << "\n";
             std::cout << "Credits: " << static_cast<int>(course->credits()) << "\n";
             std::cout << "Instructor: " << course->instructor() << "\n";
+            std::cout << "Seats taken: " << seatsLabel(*course) << "\n";
             
             if (!course->prerequisites().empty()) {
                 std::cout << "Prerequisites: ";
@@ -353,17 +540,23 @@ private:
         std::cout << "Student                  Course                   Status\n";
         std::cout << std::string(80, '-') << "\n";
         
-        for (const Enrollment* enrollment : m_enrollmentManager->getAllEnrollments()) {
-            const Student* student = m_students->findStudent(enrollment->studentId());
-            const Course* course = m_courses->findCourse(enrollment->courseId());
-            
-            if (student && course) {
-                std::cout << std::left 
-                          << std::setw(25) << student->name()
-                          << std::setw(25) << course->name()
-                          << (enrollment->isActive() ? "Active" : "Inactive") << "\n";
+        std::size_t row = 0;   // first row of the next page
+        paginate([&] {
+            const EnrollmentManager::EnrollmentView page = m_enrollmentManager->enrollmentsPage(row, kPageSize);
+            for (const Enrollment& enrollment : page) {
+                const Student* student = m_students->findStudent(enrollment.studentId());
+                const Course* course = m_courses->findCourse(enrollment.courseId());
+                
+                if (student && course) {
+                    std::cout << std::left 
+                              << std::setw(25) << student->name()
+                              << std::setw(25) << course->name()
+                              << (enrollment.isActive() ? "Active" : "Inactive") << "\n";
+                }
             }
-        }
+            row += page.size();
+            return page.size();
+        });
     }
     
     void enrollStudent() {
@@ -404,7 +597,9 @@ private:
                 std::cout << "Error: Student already enrolled in this course!\n";
                 break;
             case EnrollmentManager::EnrollmentResult::CourseFull:
-                std::cout << "Error: Course is full!\n";
+                std::cout << "Course is full. Student is #"
+                          << m_waitlistManager->getWaitlistPosition(courseId, studentId)
+                          << " on the waitlist and will be enrolled when a seat opens.\n";
                 break;
         }
     }
@@ -426,6 +621,81 @@ private:
         }
     }
     
+    void completeEnrollment() {
+        std::cout << "\n--- Mark Enrollment Completed ---\n";
+        int studentId, courseId;
+        
+        std::cout << "Student ID: ";
+        std::cin >> studentId;
+        
+        std::cout << "Course ID: ";
+        std::cin >> courseId;
+        
+        if (m_enrollmentManager->setEnrollmentStatus(studentId, courseId, Enrollment::Status::Completed)) {
+            std::cout << "Enrollment marked as completed!\n";
+        } else {
+            std::cout << "Error: Enrollment not found or already inactive.\n";
+        }
+    }
+    
+    void planPath() {
+        std::cout << "\n--- Plan Path to Courses ---\n";
+        int studentId, creditCap;
+        std::string targetStr;
+
+        std::cout << "Student ID: ";
+        std::cin >> studentId;
+        std::cin.ignore();
+
+        std::cout << "Target course IDs (comma-separated): ";
+        std::getline(std::cin, targetStr);
+
+        std::cout << "Max credits per semester: ";
+        std::cin >> creditCap;
+
+        std::vector<std::int32_t> targets;
+        std::stringstream ss(targetStr);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            try {
+                targets.push_back(std::stoi(item));
+            } catch (...) {
+                // Ignore invalid numbers
+            }
+        }
+
+        DegreePlanner::Options options;
+        options.creditCap = static_cast<unsigned>(std::max(1, creditCap));
+        const DegreePlanner planner(*m_courses, *m_enrollmentManager);
+        const DegreePlanner::Plan plan = planner.plan(studentId, targets, options);
+
+        if (plan.semesters.empty() && plan.complete()) {
+            std::cout << "Nothing left to take: all targets are completed or in progress.\n";
+        }
+        for (size_t i = 0; i < plan.semesters.size(); ++i) {
+            const DegreePlanner::Semester& semester = plan.semesters[i];
+            std::cout << "Semester " << (i + 1) << " (" << semester.credits << " credits): ";
+            for (size_t k = 0; k < semester.courses.size(); ++k) {
+                if (k > 0) std::cout << ", ";
+                const Course* course = m_courses->findCourse(semester.courses[k]);
+                std::cout << semester.courses[k];
+                if (course) std::cout << " " << course->name();
+            }
+            std::cout << "\n";
+        }
+        if (plan.semesters.size() > plan.lowerBound) {
+            std::cout << "(A " << plan.lowerBound << "-semester plan may exist.)\n";
+        }
+        if (!plan.complete()) {
+            std::cout << "Cannot be planned (unknown, removed or over the credit limit): ";
+            for (size_t i = 0; i < plan.blocked.size(); ++i) {
+                if (i > 0) std::cout << ", ";
+                std::cout << plan.blocked[i];
+            }
+            std::cout << "\n";
+        }
+    }
+
     void checkPrerequisites() {
         std::cout << "\n--- Check Prerequisites ---\n";
         int studentId, courseId;
@@ -447,6 +717,17 @@ private:
                 std::cout << missing[i];
             }
             std::cout << "\n";
+
+            auto chain = m_enrollmentManager->getPrerequisiteChain(studentId, courseId);
+            std::cout << "Full chain, in order: ";
+            for (size_t i = 0; i < chain.missing.size(); ++i) {
+                if (i > 0) std::cout << " -> ";
+                std::cout << chain.missing[i];
+            }
+            std::cout << "\n";
+            if (!chain.reachable) {
+                std::cout << "The chain includes a course that no longer exists.\n";
+            }
         }
     }
     
@@ -454,16 +735,30 @@ private:
         std::cout << "\n--- System Reports ---\n";
         std::cout << std::string(50, '=') << "\n";
         
-        std::cout << "Total Students: " << m_students->allStudents().size() << "\n";
-        std::cout << "Total Courses: " << m_courses->allCourses().size() << "\n";
-        std::cout << "Total Enrollments: " << m_enrollmentManager->getAllEnrollments().size() << "\n\n";
+        std::cout << "Total Students: " << m_students->size() << "\n";
+        std::cout << "Total Courses: " << m_courses->size() << "\n";
+        std::cout << "Total Enrollments: " << m_reports->totalEnrollments()
+                  << " (active " << m_reports->totalWithStatus(Enrollment::Status::Active)
+                  << ", completed " << m_reports->totalWithStatus(Enrollment::Status::Completed)
+                  << ", dropped " << m_reports->totalWithStatus(Enrollment::Status::Dropped)
+                  << ", withdrawn " << m_reports->totalWithStatus(Enrollment::Status::Withdrawn) << ")\n\n";
         
         std::cout << "Course Enrollment Details:\n";
         std::cout << std::string(50, '-') << "\n";
         
-        for (const Course* course : m_courses->allCourses()) {
-            auto enrollments = m_enrollmentManager->getCourseEnrollments(course->id());
-            std::cout << course->name() << ": " << enrollments.size() << " students\n";
+        for (const Course& course : m_courses->firstPage(SIZE_MAX)) {
+            const ReportAggregates::CourseTotals totals = m_reports->courseTotals(course.id());
+            std::cout << course.name() << ": " << totals.count(Enrollment::Status::Active) << " students";
+            if (totals.waitlisted > 0) {
+                std::cout << ", " << totals.waitlisted << " waitlisted";
+            }
+            std::cout << "\n";
+        }
+
+        if (Metrics::enabled()) {
+            std::cout << "\nOperation Latency (this session):\n";
+            std::cout << std::string(50, '-') << "\n";
+            std::cout << Metrics::snapshot().toText();
         }
     }
     
@@ -478,12 +773,13 @@ private:
                 hasWaitlists = true;
                 std::cout << course->name() << ": " << waitlistSize << " students waiting\n";
                 
-                auto waitlist = m_waitlistManager->getWaitlist(course->id());
-                for (size_t i = 0; i < waitlist.size(); ++i) {
-                    const Student* student = m_students->findStudent(waitlist[i]);
+                size_t i = 0;
+                for (std::int32_t studentId : *m_waitlistManager->findWaitlist(course->id())) {
+                    const Student* student = m_students->findStudent(studentId);
                     if (student) {
                         std::cout << "  " << (i + 1) << ". " << student->name() << "\n";
                     }
+                    ++i;
                 }
                 std::cout << "\n";
             }
@@ -494,6 +790,51 @@ private:
         }
     }
     
+    void bulkImport() {
+        std::cout << "\n--- Bulk Import ---\n";
+        std::cout << "1. Students    (id, name, email, phone, address[, password])\n";
+        std::cout << "2. Courses     (id, name, credits, instructor[, prerequisites])\n";
+        std::cout << "3. Enrollments (student_id, course_id[, status[, enrolled_at]])\n";
+        std::cout << "Choice: ";
+        
+        int choice = getChoice();
+        if (choice < 1 || choice > 3) {
+            std::cout << "Invalid choice.\n";
+            return;
+        }
+        
+        std::string path;
+        std::cout << "File path: ";
+        std::getline(std::cin, path);
+        
+        BulkImporter importer(*m_students, *m_courses, *m_enrollmentManager);
+        BulkImporter::Report report;
+        switch (choice) {
+            case 1: report = importer.importStudents(path); break;
+            case 2: report = importer.importCourses(path); break;
+            case 3: report = importer.importEnrollments(path); break;
+        }
+        
+        if (!report.fileOpened) {
+            std::cout << "Error: could not open " << path << "\n";
+            return;
+        }
+        
+        std::cout << "Rows read: " << report.rowsRead << "\n";
+        std::cout << "Imported: " << report.rowsImported << "\n";
+        std::cout << "Errors: " << report.errorCount << "\n";
+        std::cout << "Throughput: " << std::fixed << std::setprecision(0) << report.rowsPerSecond() << " rows/sec\n";
+        std::cout.unsetf(std::ios::floatfield);
+        
+        const size_t shown = std::min<size_t>(report.errors.size(), 10);
+        for (size_t i = 0; i < shown; ++i) {
+            std::cout << "  line " << report.errors[i].line << ": " << report.errors[i].message << "\n";
+        }
+        if (report.errorCount > shown) {
+            std::cout << "  ... and " << (report.errorCount - shown) << " more\n";
+        }
+    }
+    
     void runDemo() {
         std::cout << "\n=== Running System Demo ===\n";
         
@@ -523,10 +864,10 @@ private:
         std::cout << "Result: " << (result == EnrollmentManager::EnrollmentResult::Success ? "Success" : "Failed") << "\n";
         
         std::cout << "\n5. Current enrollments:\n";
-        for (const auto* e : m_enrollmentManager->getAllEnrollments()) {
-            const Student* student = m_students->findStudent(e->studentId());
-            const Course* course = m_courses->findCourse(e->courseId());
-            if (student && course && e->isActive()) {
+        for (const auto& e : m_enrollmentManager->getAllEnrollments()) {
+            const Student* student = m_students->findStudent(e.studentId());
+            const Course* course = m_courses->findCourse(e.courseId());
+            if (student && course && e.isActive()) {
                 std::cout << "  " << student->name() << " enrolled in " << course->name() << "\n";
             }
         }